@@ -8,31 +8,34 @@ C_SRCS += \
 ../external_eeprom.c \
 ../external_peripherals.c \
 ../i2c.c \
-../timers.c \
-../usart.c 
+../provision.c \
+../rtc.c \
+../schedule.c 
 
 OBJS += \
 ./MCU.o \
 ./external_eeprom.o \
 ./external_peripherals.o \
 ./i2c.o \
-./timers.o \
-./usart.o 
+./provision.o \
+./rtc.o \
+./schedule.o 
 
 C_DEPS += \
 ./MCU.d \
 ./external_eeprom.d \
 ./external_peripherals.d \
 ./i2c.d \
-./timers.d \
-./usart.d 
+./provision.d \
+./rtc.d \
+./schedule.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 %.o: ../%.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
-	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -c -o "$@" "$<"
+	avr-gcc -Wall -g2 -gstabs -I"../../drivers" -Os -flto -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -17,12 +17,7 @@
  *******************************************************************************/
 
 #include "MCU.h"
-
-/*******************************************************************************
- *                      Global Variables                              	   	   *
- *******************************************************************************/
-
-uint8 g_password[PASSWORD_LENGTH];		/* Variable to hold input password */
+#include <avr/pgmspace.h>
 
 /*******************************************************************************
  *                    	Function Prototypes 		                           *
@@ -32,8 +27,50 @@ void MCU_init(void);					/* Function to initiate MCU */
 void resetPassword(void);		/* Function to reset password container */
 void receiveAndSavePassword(void);		/* Function to receive password and save to external EEPROM */
 uint8 receiveAndCheckPassword(void);	/* Function to receive password and check with saved password */
-void raiseError(void);					/* Function to Start error actions */
+uint8 receiveAndConfirmPassword(void);	/* Function to receive password and check with new password */
+uint8 receivePassword(void);			/* Function to receive streamed password digits */
+void startLockout(void);				/* Function to start alarm and lockout countdown */
+void countLockoutSecond(void);			/* Function counting lockout down, timer 1 deadline callback */
 void unlockSystem(void);				/* Function to unlock system */
+void waitForData(void);					/* Function to wait for a parameter byte while serving watchdog */
+uint8 receivePasswordDigit(uint8 *a_count_Ptr, uint8 *a_digit_Ptr);	/* Function to receive one streamed password symbol */
+uint8 handleClockCommand(uint8 a_command);	/* Function to handle clock and schedule link commands */
+FSM_EventType checkPassword(bool a_open);	/* Function to receive password and send verdict */
+
+/* State activities, each runs until an event ends its state */
+FSM_EventType setupNewState(void);
+FSM_EventType setupConfirmState(void);
+FSM_EventType readyState(void);
+FSM_EventType changeCheckState(void);
+FSM_EventType openCheckState(void);
+FSM_EventType serviceCheckState(void);
+FSM_EventType unlockingState(void);
+FSM_EventType lockedState(void);
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+uint8 g_password[PASSWORD_LENGTH];		/* Variable to hold input password */
+uint8 g_newPassword[PASSWORD_LENGTH];	/* Variable to hold new password until it is confirmed */
+uint8 g_peerRestarted = FALSE;			/* Variable for checking HMI MCU restarted in middle of an exchange */
+uint8 g_errorCounter = 0;				/* Variable for counting errors occurs */
+volatile uint8 g_lockoutSecondsLeft = 0;	/* Variable to hold lockout seconds left, 0 if no lockout runs */
+
+/* Periodic timer 1 deadline counting lockout down every second */
+TIMER_DeadlineType g_lockoutDeadline = {0, TIMER1_TICKS_PER_SECOND, countLockoutSecond, NULL};
+
+/* Activity of every state of fsm.def, kept in flash */
+static const FSM_ActivityType g_activities[FSM_STATES_COUNT] PROGMEM = {
+	[FSM_STATE_SETUP_NEW] = setupNewState,
+	[FSM_STATE_SETUP_CONFIRM] = setupConfirmState,
+	[FSM_STATE_READY] = readyState,
+	[FSM_STATE_CHANGE_CHECK] = changeCheckState,
+	[FSM_STATE_OPEN_CHECK] = openCheckState,
+	[FSM_STATE_SERVICE_CHECK] = serviceCheckState,
+	[FSM_STATE_UNLOCKING] = unlockingState,
+	[FSM_STATE_LOCKED] = lockedState
+};
 
 /*******************************************************************************
  *                      Function Definitions                                   *
@@ -41,62 +78,219 @@ void unlockSystem(void);				/* Function to unlock system */
 
 int main(void){
 
-	uint8 setup = TRUE;				/* Variable for checking of setup state on MCU*/
-	uint8 changePass = FALSE;		/* Variable for checking of changing password state on MCU*/
-	uint8 openDoor = FALSE;			/* Variable for checking of opening door state on MCU*/
-	uint8 errorCounter = 0;			/* Variable for counting errors occurs */
-	uint8 actionSymbol;				/* Variable to hold action to be taken next */
+	FSM_StateType state;			/* Variable to hold current state */
+	uint8 saved;					/* Variable to hold state restored after watchdog reset */
 	MCU_init();						/* Initiate MCU */
+	state = FSM_STATE_NONE;
+	if (SUPERVISOR_restore(&saved, &g_errorCounter))	/* If MCU was restarted by watchdog resume last committed state */
+		state = FSM_resume(saved);
+	if (FSM_STATE_NONE == state){						/* On cold start */
+		g_errorCounter = 0;
+		state = PROVISION_isProvisioned() ? FSM_STATE_READY : FSM_STATE_SETUP_NEW;	/* Set up a password only if none was saved */
+	}
+	PROFILER_RECORD_SINCE_START(PROFILER_SITE_BOOT);	/* Time to ready */
+	while(1){
+		SUPERVISOR_commit(state, g_errorCounter);		/* Commit state and error counter to resume after a watchdog reset */
+		FSM_ActivityType activity = (FSM_ActivityType)pgm_read_word(&g_activities[state]);	/* Activity of state */
+		FSM_EventType event = activity();				/* Run state until an event ends it */
+		FSM_StateType next = FSM_next(state, event);	/* Look up next state */
+		if (FSM_STATE_NONE != next)						/* Ignored events run state again */
+			state = next;
+		if (FSM_EVENT_HELLO == event)					/* HMI MCU restarted, tell it where to start */
+			USART_sendByte(FSM_STATE_SETUP_NEW == state ? LINK_SETUP : LINK_READY);
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: setupNewState
+ * [Description]	: Receive new password
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType setupNewState(void){
+	PROFILER_MEASURE(PROFILER_SITE_PASSWORD, receiveAndSavePassword());	/* Receive new password */
+	if (g_peerRestarted){							/* Setup starts over */
+		g_peerRestarted = FALSE;
+		return FSM_EVENT_HELLO;
+	}
+	return FSM_EVENT_ENTERED;
+}
+
+/*******************************************************************************
+ * [Function Name]	: setupConfirmState
+ * [Description]	: Receive new password again and save it if both match
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType setupConfirmState(void){
+	uint8 match = receiveAndConfirmPassword();		/* Receive password and check it matches new one */
+	if (g_peerRestarted){							/* Setup starts over */
+		g_peerRestarted = FALSE;
+		return FSM_EVENT_HELLO;
+	}
+	if (match){
+		USART_sendByte(ACTION_SUCCESS);				/* Send success symbol */
+		PROVISION_save(g_newPassword, PASSWORD_LENGTH-1);	/* Save confirmed password and mark device provisioned */
+		return FSM_EVENT_SUCCESS;
+	}
+	USART_sendByte(ACTION_FAIL);					/* Send failure symbol */
+	resetPassword();								/* Reset password array */
+	return FSM_EVENT_FAIL;
+}
+
+/*******************************************************************************
+ * [Function Name]	: readyState
+ * [Description]	: Wait for an action, serving profiler commands and checking
+ * 					  saved password meanwhile
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType readyState(void){
+	uint8 actionSymbol;								/* Variable to hold action to be taken next */
 	while(1){
-		while(setup){									/* Enter setup state */
-			receiveAndSavePassword();					/* Receive password and start saving to EEPROM */
-			if(receiveAndCheckPassword()){				/* Receive password and check validity */
-				USART_sendByte(ACTION_SUCCESS);			/* Send success symbol */
-				setup = FALSE;							/* Disable setup state */
-				break;									/* Exit setup state */
-			}
-			else{										/* If passwords did not match */
-				USART_sendByte(ACTION_FAIL);			/* Send failure symbol */
-				resetPassword();						/* Reset password array */
-			}
+		while (!USART_receiveSymbol(&actionSymbol)){	/* Wait for new action while serving watchdog */
+			SUPERVISOR_kick();
+			PROVISION_check();						/* Check saved password in background while idle */
+			SCHEDULE_flush();						/* Retry saving schedule after a memory failure */
 		}
+		if ('*' == actionSymbol || '-' == actionSymbol)	/* If change pass or open door action received */
+			return ('*' == actionSymbol) ? FSM_EVENT_CHANGE : FSM_EVENT_OPEN;
+		else if (LINK_SERVICE == actionSymbol)		/* Service menu chosen, password comes first */
+			return FSM_EVENT_SERVICE;
+		else if (LINK_HELLO == actionSymbol)		/* HMI MCU started */
+			return FSM_EVENT_HELLO;
+		else if (LINK_STATUS == actionSymbol)		/* Late status query, no lockout runs */
+			USART_sendByte(LINK_READY);
+#if PROFILER_ENABLED
+		else if (PROFILER_REQUEST == actionSymbol)	/* If profiler report requested */
+			PROFILER_report();						/* Send profiler report */
+#endif
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: changeCheckState
+ * [Description]	: Check old password before changing it
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType changeCheckState(void){
+	return checkPassword(FALSE);
+}
+
+/*******************************************************************************
+ * [Function Name]	: openCheckState
+ * [Description]	: Check password and access window before opening door
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType openCheckState(void){
+	return checkPassword(TRUE);
+}
 
-		while(changePass || openDoor){					/* Enter change pass and open door states */
-			if(receiveAndCheckPassword()){				/* Receive password and check validity */
-				USART_sendByte(ACTION_SUCCESS); 		/* Send success symbol */
-				errorCounter = 0;						/* Reset error counter */
-				if (openDoor){							/* If active state is open door state */
-					openDoor = FALSE;					/* Disable open door state */
-					unlockSystem();						/* Unlock system */
-				}
-				else{									/* If active state is change pass state */
-					changePass = FALSE;					/* Disable change pass state */
-					setup = TRUE;						/* Disable setup state */
-				}
-				break;									/* Exit active state */
-			}
-			else{										/* If received password is not valid */
-				errorCounter++;							/* Increment error counter */
-				if (errorCounter == ERROR_LIMIT){		/* If error counter reached limit */
-					errorCounter = 0;					/* Reset error counter */
-					changePass = FALSE;					/* Disable change pass state */
-					USART_sendByte(ACTION_ERROR);		/* Send error symbol */
-					raiseError();						/* Start error actions */
-					break;								/* Exit active state */
-				}
-				else									/* If error counter did not reach limit */
-					USART_sendByte(ACTION_FAIL);		/* Send failure symbol */
-			}
+/*******************************************************************************
+ * [Function Name]	: serviceCheckState
+ * [Description]	: Check password before a service command, then apply one
+ * 					  clock or schedule command and send its result. A service
+ * 					  menu left without a command ends with LINK_SERVICE.
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType serviceCheckState(void){
+	uint8 symbol;									/* Variable to hold symbol received */
+	FSM_EventType event = checkPassword(FALSE);		/* Only password holder sets clock and schedule */
+	if (FSM_EVENT_SUCCESS != event)
+		return event;
+	while(1){
+		while (!USART_receiveSymbol(&symbol))		/* Wait for command while user fills it in */
+			SUPERVISOR_kick();
+		if (LINK_HELLO == symbol)					/* HMI MCU restarted, command will not come */
+			return FSM_EVENT_HELLO;
+		if (LINK_SERVICE == symbol)					/* Service menu left without a command */
+			return FSM_EVENT_SUCCESS;
+		if (RTC_SET_TIME_COMMAND == symbol || RTC_CALIBRATE_COMMAND == symbol || SCHEDULE_COMMAND == symbol){
+			USART_sendByte(handleClockCommand(symbol) ? ACTION_SUCCESS : ACTION_FAIL);	/* Send command result */
+			return FSM_EVENT_SUCCESS;
 		}
+	}
+}
 
-		if(!setup){										/* If setup state is not active */
-			actionSymbol = USART_receiveByte();			/* Wait for new action to enter new state */
-			if ('*' == actionSymbol)					/* If change pass action received */
-				changePass = TRUE;						/* Enable change pass state */
-			else if ('-' == actionSymbol)				/* If open door action received */
-				openDoor = TRUE;						/* Enable open door state */
+/*******************************************************************************
+ * [Function Name]	: unlockingState
+ * [Description]	: Run door open cycle
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType unlockingState(void){
+	unlockSystem();									/* Unlock system */
+	return FSM_EVENT_TIMEOUT;
+}
+
+/*******************************************************************************
+ * [Function Name]	: lockedState
+ * [Description]	: Run lockout while serving link, alarm and countdown run on
+ * 					  timer 1. Nothing ends it early and service commands wait
+ * 					  until it is over. A watchdog reset resumes it from the
+ * 					  start, a power-on or brown-out reset clears the snapshot
+ * 					  and ends it.
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType lockedState(void){
+	uint8 symbol;									/* Variable to hold symbol received */
+	startLockout();									/* Start alarm and countdown */
+	while (0 != g_lockoutSecondsLeft){				/* Until timer 1 ends lockout */
+		if (!USART_receiveSymbol(&symbol)){			/* Nothing received, serve watchdog */
+			SUPERVISOR_kick();
+			continue;
 		}
+		if (LINK_STATUS == symbol){					/* HMI MCU shows countdown */
+			USART_sendByte(LINK_COUNTDOWN);
+			USART_sendByte(g_lockoutSecondsLeft);
+		}
+		else if (LINK_HELLO == symbol)				/* HMI MCU restarted, it joins lockout */
+			USART_sendByte(LINK_LOCKED);
+#if PROFILER_ENABLED
+		else if (PROFILER_REQUEST == symbol)		/* If profiler report requested */
+			PROFILER_report();						/* Send profiler report */
+#endif
 	}
+	return FSM_EVENT_TIMEOUT;
+}
+
+/*******************************************************************************
+ * [Function Name]	: checkPassword
+ * [Description]	: Receive password, count wrong ones and send verdict to HMI MCU
+ * [Args]
+ * 		[IN] bool a_open
+ * 					: TRUE if password opens door, access window is checked too
+ *
+ * [Returns]		: Event of verdict
+ *******************************************************************************/
+FSM_EventType checkPassword(bool a_open){
+	uint8 valid = receiveAndCheckPassword();		/* Receive password and check validity */
+	if (g_peerRestarted){							/* Password was not finished, it is not an error */
+		g_peerRestarted = FALSE;
+		return FSM_EVENT_HELLO;
+	}
+	if (valid){
+		g_errorCounter = 0;							/* Reset error counter */
+		bool allowed = RTC_isSet() ? SCHEDULE_isAllowed(USER_GROUP, RTC_getSecondOfWeek())	/* Access window of user group */
+			: (SCHEDULE_ALLOW_WITHOUT_CLOCK || SCHEDULE_isUnrestricted(USER_GROUP));	/* Time unknown, fail closed unless configured */
+		if (a_open && !allowed){					/* If door is opened outside access window */
+			USART_sendByte(ACTION_DENIED);			/* Send denied symbol */
+			return FSM_EVENT_DENIED;
+		}
+		USART_sendByte(ACTION_SUCCESS); 			/* Send success symbol */
+		return FSM_EVENT_SUCCESS;
+	}
+	if (++g_errorCounter == ERROR_LIMIT){			/* If error counter reached limit */
+		g_errorCounter = 0;							/* Reset error counter */
+		USART_sendByte(ACTION_ERROR);				/* Send error symbol */
+		return FSM_EVENT_ERROR;
+	}
+	USART_sendByte(ACTION_FAIL);					/* Send failure symbol */
+	return FSM_EVENT_FAIL;
 }
 
 /*******************************************************************************
@@ -107,80 +301,130 @@ int main(void){
  *******************************************************************************/
 void MCU_init(void){
 
-	/*
-	 * Baud Rate		= BAUD_RATE_9600	-> set baud rate to 9600 bits per second
-	 * Character size	= EIGHT_BITS		-> Set data transfer size to 8 bits
-	 * Parity			= DISABLED			-> Disable parity bit
-	 * Stop bit			= ONE_BIT			-> Set only 1 stop bit
-	 */
-	Usart_ConfigType usart_configuration = {BAUD_RATE_9600, EIGHT_BITS, DISABLED, ONE_BIT};
-
-	/*
-	 * Initial value			= 0							-> Initial clock value
-	 * Top Value				= 31250						-> Max clock value
-	 * Waveform generation mode	= CLEAR_TIMER_COMPARE_ICR1	-> Clear timer compare mode
-	 * Clock prescaler			= FCPU_256					-> divide MCU clock by 256
-	 * Compare match output A	= NORMAL_OPERATION			-> Normal pin operation for OCR1A
-	 * Compare match output B	= NORMAL_OPERATION			-> Normal pin operation for OCR1B
-	 */
-	TIMERS_ConfigType timer_configuration = {0, 31250, CLEAR_TIMER_COMPARE_ICR1, FCPU_256, NORMAL_OPERATION, NORMAL_OPERATION};
+	/* Read reset cause and start watchdog supervisor */
+	SUPERVISOR_ResetCause cause = SUPERVISOR_init();
 
 	/* Clear I-bit from status register to not detect interrupts */
 	cli();
 
-	/* Initiate USART communication protocol with provided configurations */
-	USART_init(&usart_configuration);
+	/* Initiate profiler time base first if instrumentation is compiled in, boot is timed from here */
+	PROFILER_init();
 
-	/* Initiate timer 1 with provided configurations */
-	TIMER1_init(&timer_configuration);
+	/* Initiate USART communication protocol with compile-time configuration (9600 8N1) */
+	USART_initStatic();
+
+	/* Initiate timer 1 as free running deadline timer with compile-time configuration (F_CPU/64) */
+	TIMER1_initStatic();
 
 	/* Initiate external EEPROM memory */
 	EEPROM_init();
 
+	/* Read saved password once, it is verified from SRAM afterwards */
+	PROVISION_init(PASSWORD_LENGTH-1);
+
 	/* Initiate external control peripherals */
 	EXTERNALPERIPHERALS_init();
 
+	/* Initiate real time clock, going on with time set before a watchdog reset, and load access schedule from external EEPROM */
+	RTC_init(SUPERVISOR_RESET_WATCHDOG == cause);
+	SCHEDULE_init();
+
 	/* Set I-bit in status register to detect interrupts */
 	sei();
 }
 
 /*******************************************************************************
  * [Function Name]	: receiveAndSavePassword
- * [Description]	: Receive password from HMI MCU and save to external EEPROM
+ * [Description]	: Receive streamed password from HMI MCU and keep it to check
+ * 					  confirmation against, it is saved once confirmed
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
 void receiveAndSavePassword(void){
-	USART_receiveString(g_password);								/* Receive password from HMI MCU */
-	EEPROM_writeString(PASSWORD_ADDRESS, g_password);									/* Write String to memory */
-//	for (int i = 0; i < PASSWORD_LENGTH; i++)						/* Loop through password characters */
-//		EEPROM_writeByte(PASSWORD_ADDRESS+i,  g_password[i]);		/* Write character to memory */
+	receivePassword();												/* Receive digits until password is confirmed */
+	if (!g_peerRestarted)											/* Password was not finished, keep previous one */
+		for (int i = 0; i < PASSWORD_LENGTH-1; i++)					/* Confirmation is checked against new password */
+			g_newPassword[i] = g_password[i];
 	resetPassword();												/* Reset password array*/
 }
 
 /*******************************************************************************
  * [Function Name]	: receiveAndCheckPassword
- * [Description]	: Receive password from HMI MCU and check with saved password
+ * [Description]	: Receive streamed password from HMI MCU and verify it against
+ * 					  SRAM copy of saved password, no memory access while user waits
  * [Args]			: N/A
  * [Returns]		: Operation success/failure
  *******************************************************************************/
 uint8 receiveAndCheckPassword(void){
-	uint8 byteToRead;												/* Variable to save byte received from memory */
-	USART_receiveString(g_password);								/* Receive password from HMI MCU */
-	for (int i = 0; i < PASSWORD_LENGTH-1; i++){					/* Loop through password received */
-		if (EEPROM_readByte(PASSWORD_ADDRESS+i, &byteToRead)){		/* Receive byte from memory and return SUCCESS or ERROR */
-			if(g_password[i] != byteToRead){						/* If they do not match */
-				resetPassword();									/* Reset password array */
-				return ERROR;										/* Return error code */
-			}
-		}
-		else{														/* If failed to read from memory */
-			resetPassword();										/* Reset password array*/
-			return ERROR;											/* Return error code */
-		}
-	}
+	uint8 count = receivePassword();								/* Receive digits until password is confirmed */
+	uint8 valid = (PASSWORD_LENGTH-1 == count) && PROVISION_verify(g_password, PASSWORD_LENGTH-1);	/* Right length and digits */
 	resetPassword();												/* Reset password array*/
-	return SUCCESS;													/* Return success code */
+	return valid ? SUCCESS : ERROR;
+}
+
+/*******************************************************************************
+ * [Function Name]	: receiveAndConfirmPassword
+ * [Description]	: Receive streamed password from HMI MCU and check it matches
+ * 					  new password received before
+ * [Args]			: N/A
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+uint8 receiveAndConfirmPassword(void){
+	uint8 count = receivePassword();								/* Receive digits until password is confirmed */
+	uint8 match = (PASSWORD_LENGTH-1 == count);						/* Right length */
+	for (int i = 0; i < PASSWORD_LENGTH-1; i++)						/* And same digits */
+		if (g_password[i] != g_newPassword[i])
+			match = FALSE;
+	resetPassword();												/* Reset password array*/
+	return match ? SUCCESS : ERROR;
+}
+
+/*******************************************************************************
+ * [Function Name]	: receivePassword
+ * [Description]	: Receive streamed password digits from HMI MCU into g_password
+ * 					  until it is confirmed or HMI MCU restarts
+ * [Args]			: N/A
+ * [Returns]		: Number of digits received since last clear, digits that
+ * 					  do not fit are counted but not kept
+ *******************************************************************************/
+uint8 receivePassword(void){
+	uint8 count = 0;												/* Number of digits received */
+	uint8 digit;													/* Digit received */
+	while (receivePasswordDigit(&count, &digit))					/* Receive digits until password is confirmed */
+		if (count != 0 && count <= PASSWORD_LENGTH-1)				/* Keep digits that fit, nothing to keep after clear */
+			g_password[count-1] = digit;
+	return count;
+}
+
+/*******************************************************************************
+ * [Function Name]	: receivePasswordDigit
+ * [Description]	: Receive one streamed password symbol from HMI MCU
+ * [Args]
+ * 		[IN/OUT] unsigned char * a_count_Ptr
+ * 					: Number of digits received so far, incremented on digit,
+ * 					  reset to 0 on clear
+ * 		[OUT] unsigned char * a_digit_Ptr
+ * 					: Digit received
+ *
+ * [Returns]		: FALSE once password is confirmed or HMI MCU restarted
+ *******************************************************************************/
+uint8 receivePasswordDigit(uint8 *a_count_Ptr, uint8 *a_digit_Ptr){
+	uint8 symbol;													/* Symbol received */
+	PROFILER_MEASURE(PROFILER_SITE_USART_RX, while(!USART_receiveSymbol(&symbol)) SUPERVISOR_kick());	/* Wait for next symbol while serving watchdog */
+	if (PASSWORD_END == symbol)										/* Password confirmed */
+		return FALSE;
+	if (LINK_HELLO == symbol){										/* HMI MCU restarted, password will not be finished */
+		g_peerRestarted = TRUE;
+		return FALSE;
+	}
+	if (PASSWORD_CLEAR == symbol)									/* Digits cleared */
+		*a_count_Ptr = 0;
+	else{															/* Digit typed */
+		*a_digit_Ptr = symbol;
+		if (*a_count_Ptr != 0xFF)									/* Do not wrap on a flood of digits */
+			(*a_count_Ptr)++;
+	}
+	return TRUE;
 }
 
 /*******************************************************************************
@@ -195,17 +439,29 @@ void resetPassword(void){
 }
 
 /*******************************************************************************
- * [Function Name]	: raiseError
- * [Description]	: Start MCU error actions
+ * [Function Name]	: startLockout
+ * [Description]	: Start alarm and count lockout down on timer 1
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
-void raiseError(void){
-	TIMER1_start();							/* Start timer 1 */
-	EXTERNALPERIPHERALS_startAlarm();		/* Start Alarm */
-	while(g_timePassed <= 60);				/* Wait for 1 minute */
-	EXTERNALPERIPHERALS_stopAlarm();		/* Stop Alarm */
-	TIMER1_stop();							/* Stop timer 1 */
+void startLockout(void){
+	g_lockoutSecondsLeft = LOCKOUT_SECONDS;					/* Count down whole lockout */
+	EXTERNALPERIPHERALS_startAlarm();						/* Start Alarm */
+	TIMER1_schedule(&g_lockoutDeadline, TIMER1_TICKS_PER_SECOND);
+}
+
+/*******************************************************************************
+ * [Function Name]	: countLockoutSecond
+ * [Description]	: Count a lockout second, stopping alarm and deadline at end
+ * 					  of lockout. Runs in timer 1 interrupt context.
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void countLockoutSecond(void){
+	if (0 == --g_lockoutSecondsLeft){						/* Lockout ended */
+		EXTERNALPERIPHERALS_stopAlarm();					/* Stop Alarm */
+		TIMER1_cancel(&g_lockoutDeadline);					/* Drop deadline already re-armed */
+	}
 }
 
 /*******************************************************************************
@@ -217,11 +473,61 @@ void raiseError(void){
 void unlockSystem(void){
 	TIMER1_start();						/* Start timer 1 */
 	EXTERNALPERIPHERALS_openDoor();		/* Start door motor to open */
-	while(g_timePassed <= 15);			/* Wait for 15 seconds */
+	PROFILER_MEASURE(PROFILER_SITE_TIMER_WAIT, while(g_timePassed <= 15) SUPERVISOR_kick());	/* Wait for 15 seconds */
 	EXTERNALPERIPHERALS_holdDoor();		/* Stop door motor */
-	while(g_timePassed <= 18);			/* Wait for 3 seconds */
+	PROFILER_MEASURE(PROFILER_SITE_TIMER_WAIT, while(g_timePassed <= 18) SUPERVISOR_kick());	/* Wait for 3 seconds */
 	EXTERNALPERIPHERALS_closeDoor();	/* Start door motor to close */
-	while(g_timePassed <= 33);			/* Wait for 15 seconds */
+	PROFILER_MEASURE(PROFILER_SITE_TIMER_WAIT, while(g_timePassed <= 33) SUPERVISOR_kick());	/* Wait for 15 seconds */
 	EXTERNALPERIPHERALS_holdDoor();		/* Stop door motor */
 	TIMER1_stop();						/* Start timer 1 */
 }
+
+/*******************************************************************************
+ * [Function Name]	: waitForData
+ * [Description]	: Wait for a command parameter byte while serving watchdog
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void waitForData(void){
+	PROFILER_MEASURE(PROFILER_SITE_USART_RX, while(!USART_isByteReceived()) SUPERVISOR_kick());	/* Kick watchdog until data arrives */
+}
+
+/*******************************************************************************
+ * [Function Name]	: handleClockCommand
+ * [Description]	: Receive parameters of a clock or schedule link command and apply it,
+ * 					  commands are only taken from service menu after password
+ *
+ * 					  '@' weekday hour minute second	-> set time
+ * 					  '^' ppm low byte, ppm high byte	-> set clock calibration
+ * 					  '&' group days sh sm eh em		-> add access window, days 0 clears group
+ *
+ * 					  Time is not trusted until set, so before the first '@'
+ * 					  command after power up a group with any access window
+ * 					  is denied (SCHEDULE_ALLOW_WITHOUT_CLOCK). A watchdog
+ * 					  reset keeps time set.
+ * [Args]
+ * 		[IN] unsigned char a_command
+ * 					: Command symbol received
+ *
+ * [Returns]		: Operation success/failure (failure on out of range parameters
+ * 					  or calibration not saved, schedule retries saving when idle)
+ *******************************************************************************/
+uint8 handleClockCommand(uint8 a_command){
+	uint8 params[6];											/* Command parameters */
+	uint8 count = (SCHEDULE_COMMAND == a_command) ? 6 : (RTC_SET_TIME_COMMAND == a_command) ? 4 : 2;	/* Number of parameters */
+	for (uint8 i = 0; i < count; i++){							/* Receive parameters */
+		waitForData();											/* Wait for parameter while serving watchdog */
+		params[i] = USART_receiveByte();
+	}
+	if (RTC_SET_TIME_COMMAND == a_command){						/* Set time of the week */
+		RTC_TimeType time = {params[0], params[1], params[2], params[3]};
+		return RTC_setTime(&time);
+	}
+	if (RTC_CALIBRATE_COMMAND == a_command)						/* Set clock calibration */
+		return RTC_setCalibration((sint16)(((uint16)params[1] << 8) | params[0]));
+	uint8 result = (0 == params[1]) ? SCHEDULE_clear(params[0])	/* Clear schedule of group */
+		: SCHEDULE_allow(params[0], params[1], params[2], params[3], params[4], params[5]);	/* Add access window to group */
+	while (SCHEDULE_flush())									/* Save changed bytes while serving watchdog */
+		SUPERVISOR_kick();
+	return result;
+}
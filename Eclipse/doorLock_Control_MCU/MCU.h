@@ -23,14 +23,21 @@
 #include "external_eeprom.h"
 #include "external_peripherals.h"
 #include "timers.h"
+#include "profiler.h"
+#include "supervisor.h"
+#include "rtc.h"
+#include "schedule.h"
+#include "provision.h"
+#include "fsm.h"
 
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
 
 #define PASSWORD_LENGTH 	6			/* Length of password containers		 	*/
-#define PASSWORD_ADDRESS	0x00FF		/* Address to save password in memory 		*/
 #define ERROR_LIMIT 		3			/* Number of times before activating error	*/
+#define USER_GROUP			0			/* Schedule group of password holder		*/
+#define LOCKOUT_SECONDS		60			/* Lockout length after error limit reached	*/
 
 /* Success and Error codes */
 #define SUCCESS 1
@@ -40,5 +47,23 @@
 #define ACTION_SUCCESS 	'!'
 #define ACTION_FAIL		')'
 #define ACTION_ERROR	'E'
+#define ACTION_DENIED	'D'
+
+/* Start up handshake, HMI MCU asks for state on its cold start */
+#define LINK_HELLO		'H'			/* HMI MCU started, asks for state */
+#define LINK_SETUP		'S'			/* No password saved, set one up */
+#define LINK_READY		'R'			/* Password saved, wait for actions */
+#define LINK_LOCKED		'L'			/* Lockout running, HMI MCU joins it */
+
+/* Served while locked out, status query is answered with ready when no lockout runs */
+#define LINK_STATUS		'Q'			/* Status query from HMI MCU */
+#define LINK_COUNTDOWN	'C'			/* Lockout running, followed by seconds left */
+
+/* Service menu, password and then one clock or schedule command follow */
+#define LINK_SERVICE	'$'			/* Service menu chosen, sent again to leave it without a command */
+
+/* Streamed password symbols, digits are sent as typed */
+#define PASSWORD_END	'\0'		/* Password confirmed, same as string terminator */
+#define PASSWORD_CLEAR	'\b'		/* Digits typed so far are dropped */
 
 #endif /* MCU_H_ */
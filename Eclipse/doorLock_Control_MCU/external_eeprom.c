@@ -18,6 +18,7 @@
 
 #include "external_eeprom.h"
 #include "i2c.h"
+#include "profiler.h"
 
 /*******************************************************************************
  *                      Function Definitions                                   *
@@ -58,7 +59,7 @@ void EEPROM_init(void){
 uint8 EEPROM_writeByte(uint16 a_address, uint8 a_data){
 
 	/* Delay between stop and start conditions */
-	_delay_ms(10);
+	PROFILER_MEASURE(PROFILER_SITE_EEPROM_WRITE, _delay_ms(10));
 
 	/* Initiate TWI connection by sending start condition */
 	TWI_start();
@@ -146,6 +147,72 @@ uint8 EEPROM_readByte(uint16 a_address, uint8 *a_data_Ptr){
 	return SUCCESS;
 }
 
+/*******************************************************************************
+ * [Function Name]	: EEPROM_readBlock
+ * [Description]	: Read consecutive bytes from memory in one sequential read,
+ * 					  address is sent once for the whole block
+ * [Args]
+ * 		[IN] unsigned short a_address
+ * 					: Memory address of first byte
+ * 		[OUT] unsigned char * a_data_Ptr
+ * 					: Buffer to read data into
+ * 		[IN] unsigned char a_length
+ * 					: Number of bytes to read, at least 1
+ *
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+uint8 EEPROM_readBlock(uint16 a_address, uint8 *a_data_Ptr, uint8 a_length){
+
+	/* Initiate TWI connection by sending start condition */
+	TWI_start();
+	/* Check status of status register to assert correct status */
+	if (TWI_getStatus() != TWI_START)
+		return ERROR;
+
+	/* Send slave address and 3 MSBs of memory address with write bit set */
+	TWI_write((uint8)(0xA0 | ((a_address & 0x0700) >> 7)));
+	/* Check status of status register to assert correct status */
+	if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
+		return ERROR;
+
+	/* Send 8 LSBs of memory address */
+	TWI_write((uint8)a_address);
+	/* Check status of status register to assert correct status */
+	if (TWI_getStatus() != TWI_MT_DATA_ACK)
+		return ERROR;
+
+	/* Send repeated start condition to hold master and change action */
+	TWI_start();
+	/* Check status of status register to assert correct status */
+	if (TWI_getStatus() != TWI_REP_START)
+		return ERROR;
+
+	/* Send slave address and 3 MSBs of memory address with read bit set */
+	TWI_write((uint8)(0xA1 | ((a_address & 0x0700) >> 7)));
+	/* Check status of status register to assert correct status */
+	if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
+		return ERROR;
+
+	/* Acknowledge every byte but last so memory keeps sending from next address */
+	while (--a_length){
+		*a_data_Ptr++ = TWI_readWithACK();
+		/* Check status of status register to assert correct status */
+		if (TWI_getStatus() != TWI_MR_DATA_ACK)
+			return ERROR;
+	}
+
+	/* Read last byte and end read */
+	*a_data_Ptr = TWI_readWithNACK();
+	/* Check status of status register to assert correct status */
+	if (TWI_getStatus() != TWI_MR_DATA_NACK)
+		return ERROR;
+
+	/* Terminate TWI connection by sending stop condition */
+	TWI_stop();
+	/* Return Success condition */
+	return SUCCESS;
+}
+
 /*******************************************************************************
  * [Function Name]	: EEPROM_writeString
  * [Description]	: Write a string to memory starting at the specified address
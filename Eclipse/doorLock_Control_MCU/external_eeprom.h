@@ -69,6 +69,22 @@ uint8 EEPROM_writeByte(uint16 a_address, uint8 a_data);
  *******************************************************************************/
 uint8 EEPROM_readByte(uint16 a_address, uint8 *a_data_Ptr);
 
+/*******************************************************************************
+ * [Function Name]	: EEPROM_readBlock
+ * [Description]	: Read consecutive bytes from memory in one sequential read,
+ * 					  address is sent once for the whole block
+ * [Args]
+ * 		[IN] unsigned short a_address
+ * 					: Memory address of first byte
+ * 		[OUT] unsigned char * a_data_Ptr
+ * 					: Buffer to read data into
+ * 		[IN] unsigned char a_length
+ * 					: Number of bytes to read, at least 1
+ *
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+uint8 EEPROM_readBlock(uint16 a_address, uint8 *a_data_Ptr, uint8 a_length);
+
 /*******************************************************************************
  * [Function Name]	: EEPROM_writeString
  * [Description]	: Write a string to memory starting at the specified address
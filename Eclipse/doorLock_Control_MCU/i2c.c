@@ -17,6 +17,7 @@
  *******************************************************************************/
 
 #include "i2c.h"
+#include "profiler.h"
 
 /*******************************************************************************
  *                      Function Definitions                                   *
@@ -85,7 +86,7 @@ void TWI_start(void){
 	TWCR = (HIGH << TWINT) | (HIGH << TWSTA) | (HIGH << TWEN);
 
 	/* Poll waiting until TWINT is set indicating a finished job */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	PROFILER_MEASURE(PROFILER_SITE_TWI, while(BIT_IS_CLEAR(TWCR,TWINT)));
 }
 
 /*******************************************************************************
@@ -136,7 +137,7 @@ void TWI_write(uint8 a_data){
 	TWCR = (HIGH << TWINT) | (HIGH << TWEN);
 
 	/* Poll waiting until TWINT is set indicating a finished job */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	PROFILER_MEASURE(PROFILER_SITE_TWI, while(BIT_IS_CLEAR(TWCR,TWINT)));
 
 }
 
@@ -161,7 +162,7 @@ uint8 TWI_readWithACK(void){
 	TWCR = (HIGH << TWINT) | (HIGH << TWEA) | (HIGH << TWEN);
 
 	/* Poll waiting until TWINT is set indicating a finished job */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	PROFILER_MEASURE(PROFILER_SITE_TWI, while(BIT_IS_CLEAR(TWCR,TWINT)));
 
 	/* Return data received in TWDR */
 	return TWDR;
@@ -188,7 +189,7 @@ uint8 TWI_readWithNACK(void){
 	TWCR = (HIGH << TWINT) | (HIGH << TWEN);
 
 	/* Poll waiting until TWINT is set indicating a finished job */
-	while(BIT_IS_CLEAR(TWCR,TWINT));
+	PROFILER_MEASURE(PROFILER_SITE_TWI, while(BIT_IS_CLEAR(TWCR,TWINT)));
 
 	/* Return data received in TWDR */
 	return TWDR;
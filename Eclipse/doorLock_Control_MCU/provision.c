@@ -0,0 +1,308 @@
+/******************************************************************************
+ *
+ * 		Module: Provisioning
+ *
+ *	 File Name: provision.c
+ *
+ * Description: Source file for provisioning record holding the saved password
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "provision.h"
+#include "external_eeprom.h"
+#include "timers.h"
+#include <util/crc16.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Header byte offsets in record */
+#define PROVISION_MAGIC_OFFSET		0
+#define PROVISION_VERSION_OFFSET	1
+#define PROVISION_CRC_OFFSET		2
+
+/* Time between background checks of SRAM copy against saved record */
+#define PROVISION_CHECK_PERIOD		TIMER1_MS_TO_TICKS(30000)
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: PROVISION_SlotState
+ * [Description]	: Enum for what reading a record copy found
+ *******************************************************************************/
+typedef enum
+{
+	PROVISION_EMPTY,			/* Read back without marker, never written */
+	PROVISION_VALID,			/* Marker, version and CRC match */
+	PROVISION_CORRUPT			/* Marker present but record bad, or memory not readable */
+}PROVISION_SlotState;
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+static uint8 g_credential[PROVISION_MAX_CREDENTIAL];	/* SRAM copy of saved credential */
+static uint16 g_credentialCrc;						/* CRC of SRAM copy, same as record CRC */
+static uint8 g_length;								/* Credential length */
+static bool g_provisioned;							/* A record was found or saved, even if corrupted */
+static bool g_intact;								/* SRAM copy holds a verified credential */
+static volatile bool g_checkDue;					/* Background check of record is due */
+
+/* Record copies, primary is written last so one of them survives an interrupted save */
+static const uint16 g_slots[] = {PROVISION_MIRROR_ADDRESS, PROVISION_ADDRESS};
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+static uint16 PROVISION_crc(const uint8 *a_credential_Ptr, uint8 a_length);	/* Calculate record CRC */
+static PROVISION_SlotState PROVISION_read(uint16 a_address, uint8 *a_credential_Ptr);	/* Read and check one record copy */
+static PROVISION_SlotState PROVISION_load(uint8 *a_credential_Ptr);	/* Read credential from first valid copy */
+static uint8 PROVISION_write(uint16 a_address, const uint8 *a_credential_Ptr);	/* Write one record copy */
+static void PROVISION_requestCheck(void);					/* Check deadline callback */
+
+/* Periodic timer 1 deadline requesting a background check of record */
+static TIMER_DeadlineType g_checkDeadline = {0, PROVISION_CHECK_PERIOD, PROVISION_requestCheck, NULL};
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_init
+ * [Description]	: Read provisioning record once into SRAM copy and start
+ * 					  background checks of record
+ * [Args]
+ * 		[IN] unsigned char a_length
+ * 					: Credential length, up to PROVISION_MAX_CREDENTIAL
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROVISION_init(uint8 a_length){
+	g_length = (a_length > PROVISION_MAX_CREDENTIAL) ? PROVISION_MAX_CREDENTIAL : a_length;
+	PROVISION_SlotState state = PROVISION_load(g_credential);	/* Read record copies */
+	g_provisioned = (PROVISION_EMPTY != state);					/* Only a never written record allows setup */
+	g_intact = (PROVISION_VALID == state);						/* Corrupted record fails every check */
+	g_credentialCrc = PROVISION_crc(g_credential, g_length);	/* Protects SRAM copy from stray writes */
+	TIMER1_schedule(&g_checkDeadline, PROVISION_CHECK_PERIOD);	/* Start background checks */
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_isProvisioned
+ * [Description]	: Check a credential was saved
+ * [Args]			: N/A
+ * [Returns]		: TRUE unless record was never written, a corrupted or
+ * 					  unreadable record still counts as provisioned
+ *******************************************************************************/
+bool PROVISION_isProvisioned(void){
+	return g_provisioned;
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_verify
+ * [Description]	: Compare a credential with SRAM copy of saved one
+ * [Args]
+ * 		[IN] const unsigned char * a_credential_Ptr
+ * 					: Credential to verify
+ * 		[IN] unsigned char a_length
+ * 					: Credential length
+ *
+ * [Returns]		: TRUE if credential matches saved one
+ *******************************************************************************/
+bool PROVISION_verify(const uint8 *a_credential_Ptr, uint8 a_length){
+	if (!g_intact || a_length != g_length)
+		return FALSE;
+	if (PROVISION_crc(g_credential, g_length) != g_credentialCrc){	/* SRAM copy corrupted */
+		g_checkDue = TRUE;										/* Reload it on next check */
+		return FALSE;
+	}
+	uint8 difference = 0;										/* Bits differing between credentials */
+	for (uint8 i = 0; i < g_length; i++)						/* Compare all digits, time does not depend on first wrong one */
+		difference |= a_credential_Ptr[i] ^ g_credential[i];
+	return (0 == difference);
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_save
+ * [Description]	: Refresh SRAM copy and save credential to both record copies,
+ * 					  mirror first then primary, each with its header written
+ * 					  last. An interrupted save leaves one intact copy.
+ * [Args]
+ * 		[IN] const unsigned char * a_credential_Ptr
+ * 					: Credential to save
+ * 		[IN] unsigned char a_length
+ * 					: Credential length, as given to PROVISION_init
+ *
+ * [Returns]		: Operation success/failure, a failed write is retried by
+ * 					  background check
+ *******************************************************************************/
+uint8 PROVISION_save(const uint8 *a_credential_Ptr, uint8 a_length){
+	if (a_length != g_length)
+		return ERROR;
+	for (uint8 i = 0; i < g_length; i++)						/* Refresh SRAM copy */
+		g_credential[i] = a_credential_Ptr[i];
+	g_credentialCrc = PROVISION_crc(g_credential, g_length);
+	g_provisioned = TRUE;
+	g_intact = TRUE;
+	for (uint8 slot = 0; slot < sizeof(g_slots)/sizeof(g_slots[0]); slot++)	/* Mirror first, primary last */
+		if (!PROVISION_write(g_slots[slot], g_credential)){
+			g_checkDue = TRUE;									/* Write again on next check */
+			return ERROR;
+		}
+	return SUCCESS;
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_check
+ * [Description]	: Check SRAM copy and saved record against each other once
+ * 					  every PROVISION_CHECK_PERIOD, call while idle
+ *
+ * 					  A corrupted SRAM copy, or one that could not be read at
+ * 					  boot, is read again from memory. A record copy that is
+ * 					  corrupted or differs from SRAM copy is written again
+ * 					  from it.
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROVISION_check(void){
+	uint8 saved[PROVISION_MAX_CREDENTIAL];						/* Credential as saved in memory */
+	if (!g_checkDue || !g_provisioned)							/* Nothing to do between checks or before setup */
+		return;
+	g_checkDue = FALSE;
+	if (!g_intact || PROVISION_crc(g_credential, g_length) != g_credentialCrc){	/* SRAM copy missing or corrupted */
+		g_intact = (PROVISION_VALID == PROVISION_load(saved));	/* Read it again, retried on next check if it fails */
+		if (g_intact){
+			for (uint8 i = 0; i < g_length; i++)
+				g_credential[i] = saved[i];
+			g_credentialCrc = PROVISION_crc(g_credential, g_length);
+		}
+		return;
+	}
+	for (uint8 slot = 0; slot < sizeof(g_slots)/sizeof(g_slots[0]); slot++){
+		bool same = (PROVISION_VALID == PROVISION_read(g_slots[slot], saved));	/* Copy is valid */
+		for (uint8 i = 0; same && i < g_length; i++)			/* And holds SRAM copy */
+			same = (saved[i] == g_credential[i]);
+		if (!same)
+			PROVISION_write(g_slots[slot], g_credential);		/* Repair copy from SRAM copy */
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_requestCheck
+ * [Description]	: Mark background check due, runs in timer interrupt context
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void PROVISION_requestCheck(void){
+	g_checkDue = TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_load
+ * [Description]	: Read credential from primary record copy, or from mirror if
+ * 					  primary is not valid
+ * [Args]
+ * 		[OUT] unsigned char * a_credential_Ptr
+ * 					: Buffer to read saved credential into, untouched if no copy is valid
+ *
+ * [Returns]		: Valid if a copy was valid, empty only if both were never
+ * 					  written, corrupt otherwise
+ *******************************************************************************/
+static PROVISION_SlotState PROVISION_load(uint8 *a_credential_Ptr){
+	PROVISION_SlotState primary = PROVISION_read(PROVISION_ADDRESS, a_credential_Ptr);
+	if (PROVISION_VALID == primary)
+		return PROVISION_VALID;
+	PROVISION_SlotState mirror = PROVISION_read(PROVISION_MIRROR_ADDRESS, a_credential_Ptr);
+	if (PROVISION_VALID == mirror)
+		return PROVISION_VALID;
+	return (PROVISION_EMPTY == primary && PROVISION_EMPTY == mirror) ? PROVISION_EMPTY : PROVISION_CORRUPT;
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_read
+ * [Description]	: Read one record copy in one block and check its header
+ *
+ * 					  Copy is valid if marker and version match and CRC covers
+ * 					  version, credential length and credential. Erased memory
+ * 					  reads as empty. A marker with a bad version or CRC, or a
+ * 					  failed read, is corrupt and never taken as empty.
+ * [Args]
+ * 		[IN] unsigned short a_address
+ * 					: Address of record copy
+ * 		[OUT] unsigned char * a_credential_Ptr
+ * 					: Buffer to read saved credential into, untouched if copy is not valid
+ *
+ * [Returns]		: State of record copy
+ *******************************************************************************/
+static PROVISION_SlotState PROVISION_read(uint16 a_address, uint8 *a_credential_Ptr){
+	uint8 record[PROVISION_HEADER_SIZE + PROVISION_MAX_CREDENTIAL];	/* Header and credential as saved */
+	if (!EEPROM_readBlock(a_address, record, PROVISION_HEADER_SIZE + g_length))	/* One read for whole copy */
+		return PROVISION_CORRUPT;								/* Memory state unknown, do not allow setup */
+	if (record[PROVISION_MAGIC_OFFSET] != PROVISION_MAGIC)
+		return PROVISION_EMPTY;									/* Never written */
+
+	uint16 crc = ((uint16)record[PROVISION_CRC_OFFSET+1] << 8) | record[PROVISION_CRC_OFFSET];	/* Saved CRC */
+	if (record[PROVISION_VERSION_OFFSET] != PROVISION_VERSION ||
+		PROVISION_crc(record + PROVISION_HEADER_SIZE, g_length) != crc)
+		return PROVISION_CORRUPT;								/* Other layout, corrupted or save interrupted */
+
+	for (uint8 i = 0; i < g_length; i++)						/* Hand credential over */
+		a_credential_Ptr[i] = record[PROVISION_HEADER_SIZE + i];
+	return PROVISION_VALID;
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_write
+ * [Description]	: Write credential then header of one record copy
+ * [Args]
+ * 		[IN] unsigned short a_address
+ * 					: Address of record copy
+ * 		[IN] const unsigned char * a_credential_Ptr
+ * 					: Credential to write
+ *
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+static uint8 PROVISION_write(uint16 a_address, const uint8 *a_credential_Ptr){
+	uint16 crc = PROVISION_crc(a_credential_Ptr, g_length);	/* Header protects credential */
+	for (uint8 i = 0; i < g_length; i++)						/* Write credential */
+		if (!EEPROM_writeByte(a_address + PROVISION_HEADER_SIZE + i, a_credential_Ptr[i]))
+			return ERROR;
+	if (EEPROM_writeByte(a_address + PROVISION_VERSION_OFFSET, PROVISION_VERSION) &&
+		EEPROM_writeByte(a_address + PROVISION_CRC_OFFSET, (uint8)crc) &&
+		EEPROM_writeByte(a_address + PROVISION_CRC_OFFSET + 1, (uint8)(crc >> 8)) &&
+		EEPROM_writeByte(a_address + PROVISION_MAGIC_OFFSET, PROVISION_MAGIC))
+		return SUCCESS;
+	return ERROR;
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_crc
+ * [Description]	: Calculate CRC16 over record version, credential length and
+ * 					  credential
+ * [Args]
+ * 		[IN] const unsigned char * a_credential_Ptr
+ * 					: Credential
+ * 		[IN] unsigned char a_length
+ * 					: Credential length
+ *
+ * [Returns]		: CRC16 of record
+ *******************************************************************************/
+static uint16 PROVISION_crc(const uint8 *a_credential_Ptr, uint8 a_length){
+	uint16 crc = 0xFFFF;								/* CRC initial value */
+	crc = _crc_ccitt_update(crc, PROVISION_VERSION);	/* Add version */
+	crc = _crc_ccitt_update(crc, a_length);				/* Add length */
+	for (uint8 i = 0; i < a_length; i++)				/* Add credential */
+		crc = _crc_ccitt_update(crc, a_credential_Ptr[i]);
+	return crc;
+}
@@ -0,0 +1,112 @@
+ /******************************************************************************
+ *
+ * 		Module: Provisioning
+ *
+ *	 File Name: provision.h
+ *
+ * Description: Header file for provisioning record holding the saved password
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef PROVISION_H_
+#define PROVISION_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Record is a header followed by the credential, read together in one block.
+ * It is kept twice, primary copy is preferred and mirror covers an interrupted save */
+#define PROVISION_ADDRESS		0x00FB		/* Address to save primary copy in memory		*/
+#define PROVISION_HEADER_SIZE	4			/* Magic, version, CRC low byte, CRC high byte	*/
+#define PROVISION_MAX_CREDENTIAL	8		/* Longest credential record holds				*/
+#define PROVISION_SLOT_SIZE		(PROVISION_HEADER_SIZE + PROVISION_MAX_CREDENTIAL)	/* Bytes of one copy */
+#define PROVISION_MIRROR_ADDRESS	(PROVISION_ADDRESS + PROVISION_SLOT_SIZE)	/* Mirror follows primary */
+
+#define PROVISION_MAGIC			0x5A		/* Marks a record written by this firmware		*/
+#define PROVISION_VERSION		1			/* Record layout version, bump on layout change	*/
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_init
+ * [Description]	: Read provisioning record once into SRAM copy and start
+ * 					  background checks of record
+ * [Args]
+ * 		[IN] unsigned char a_length
+ * 					: Credential length, up to PROVISION_MAX_CREDENTIAL
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROVISION_init(uint8 a_length);
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_isProvisioned
+ * [Description]	: Check a credential was saved
+ * [Args]			: N/A
+ * [Returns]		: TRUE unless record was never written, a corrupted or
+ * 					  unreadable record still counts as provisioned
+ *******************************************************************************/
+bool PROVISION_isProvisioned(void);
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_verify
+ * [Description]	: Compare a credential with SRAM copy of saved one, no memory
+ * 					  access. SRAM copy is checked against its CRC first, a
+ * 					  corrupted copy or a corrupted record fails verification
+ * 					  until a valid one is read.
+ * [Args]
+ * 		[IN] const unsigned char * a_credential_Ptr
+ * 					: Credential to verify
+ * 		[IN] unsigned char a_length
+ * 					: Credential length
+ *
+ * [Returns]		: TRUE if credential matches saved one
+ *******************************************************************************/
+bool PROVISION_verify(const uint8 *a_credential_Ptr, uint8 a_length);
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_save
+ * [Description]	: Refresh SRAM copy and save credential to both record copies,
+ * 					  mirror first then primary, each with its header written
+ * 					  last. An interrupted save leaves one intact copy.
+ * [Args]
+ * 		[IN] const unsigned char * a_credential_Ptr
+ * 					: Credential to save
+ * 		[IN] unsigned char a_length
+ * 					: Credential length, as given to PROVISION_init
+ *
+ * [Returns]		: Operation success/failure, a failed write is retried by
+ * 					  background check
+ *******************************************************************************/
+uint8 PROVISION_save(const uint8 *a_credential_Ptr, uint8 a_length);
+
+/*******************************************************************************
+ * [Function Name]	: PROVISION_check
+ * [Description]	: Check SRAM copy and saved record against each other once
+ * 					  every PROVISION_CHECK_PERIOD, call while idle
+ *
+ * 					  A corrupted SRAM copy, or one that could not be read at
+ * 					  boot, is read again from memory. A record copy that is
+ * 					  corrupted or differs from SRAM copy is written again
+ * 					  from it.
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROVISION_check(void);
+
+#endif /* PROVISION_H_ */
@@ -0,0 +1,196 @@
+/******************************************************************************
+ *
+ * 		Module: Real Time Clock
+ *
+ *	 File Name: rtc.c
+ *
+ * Description: Source file for software real time clock
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "rtc.h"
+#include "external_eeprom.h"
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+/* Time is kept in .noinit so start-up code does not clear it on a watchdog reset */
+static volatile uint32 g_secondOfWeek __attribute__((section(".noinit")));	/* Seconds passed since Monday 00:00:00 */
+static volatile uint32 g_timeCheck __attribute__((section(".noinit")));		/* Inverted second of week while time is set */
+static volatile sint16 g_calibration;		/* Clock rate correction in ppm */
+static volatile sint16 g_drift;				/* Correction accumulated but not applied yet in ppm */
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+static void RTC_countSecond(void);			/* Seconds deadline callback */
+
+/* Periodic timer 1 deadline ending every second, period is trimmed by calibration */
+static TIMER_DeadlineType g_secondDeadline = {0, TIMER1_TICKS_PER_SECOND, RTC_countSecond, NULL};
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: RTC_countSecond
+ * [Description]	: Count a second of the week and trim length of a coming second,
+ * 					  deadline is already re-armed so trim applies one second later
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void RTC_countSecond(void){
+	bool set = (g_timeCheck == ~g_secondOfWeek);	/* Time was set */
+	if (++g_secondOfWeek >= RTC_SECONDS_PER_WEEK)	/* Wrap at end of week */
+		g_secondOfWeek = 0;
+	if (set)
+		g_timeCheck = ~g_secondOfWeek;				/* Keep time valid for a watchdog reset */
+
+	/* Spread calibration over seconds, one tick shorter/longer every 8ppm accumulated */
+	g_drift += g_calibration;
+	sint16 ticks = g_drift / (sint16)RTC_PPM_PER_TICK;		/* Whole ticks to correct */
+	g_drift -= ticks * (sint16)RTC_PPM_PER_TICK;			/* Keep remainder for next seconds */
+	g_secondDeadline.period = TIMER1_TICKS_PER_SECOND - ticks;	/* Positive calibration shortens second */
+}
+
+/*******************************************************************************
+ * [Function Name]	: RTC_init
+ * [Description]	: Load calibration from external EEPROM and start counting seconds
+ * [Args]
+ * 		[IN] bool a_keepTime
+ * 					: TRUE after a watchdog reset, time set before it goes on
+ * 					  from last counted second (late by reset and start up time)
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void RTC_init(bool a_keepTime){
+	uint8 low, high, check;			/* Calibration bytes read from memory */
+
+	/* Time left in memory is trusted only after a watchdog reset and only if it passes check */
+	if (!a_keepTime || g_timeCheck != ~g_secondOfWeek || g_secondOfWeek >= RTC_SECONDS_PER_WEEK){
+		g_secondOfWeek = 0;
+		g_timeCheck = 0;			/* Time not set */
+	}
+
+	/* Calibration is saved as low byte, high byte and inverted XOR of both as check */
+	g_calibration = 0;
+	if (EEPROM_readByte(RTC_CALIBRATION_ADDRESS, &low) &&
+		EEPROM_readByte(RTC_CALIBRATION_ADDRESS+1, &high) &&
+		EEPROM_readByte(RTC_CALIBRATION_ADDRESS+2, &check) &&
+		(uint8)~(low ^ high) == check)
+		g_calibration = (sint16)(((uint16)high << 8) | low);
+	if (g_calibration > RTC_MAX_PPM || g_calibration < -RTC_MAX_PPM)	/* Ignore calibration out of range */
+		g_calibration = 0;
+
+	/* Count seconds on a periodic timer 1 deadline */
+	TIMER1_schedule(&g_secondDeadline, TIMER1_TICKS_PER_SECOND);
+}
+
+/*******************************************************************************
+ * [Function Name]	: RTC_setTime
+ * [Description]	: Set current time of the week
+ * [Args]
+ * 		[IN] const RTC_TimeType * a_time_Ptr
+ * 					: Time to set clock to
+ *
+ * [Returns]		: Operation success/failure (failure on out of range time)
+ *******************************************************************************/
+uint8 RTC_setTime(const RTC_TimeType *a_time_Ptr){
+	if (a_time_Ptr->weekday > 6 || a_time_Ptr->hour > 23 || a_time_Ptr->minute > 59 || a_time_Ptr->second > 59)
+		return ERROR;											/* Reject out of range time */
+
+	uint32 second = ((uint32)a_time_Ptr->weekday * 24 + a_time_Ptr->hour) * 3600UL +
+					(uint16)a_time_Ptr->minute * 60 + a_time_Ptr->second;	/* Convert to second of week */
+
+	uint8 sreg = SREG;						/* Save interrupt state */
+	cli();									/* Update clock atomically */
+	g_secondOfWeek = second;				/* Set new time */
+	g_timeCheck = ~second;					/* Mark time as valid */
+	SREG = sreg;							/* Restore interrupt state */
+	TIMER1_schedule(&g_secondDeadline, TIMER1_TICKS_PER_SECOND);	/* Start second from beginning */
+	return SUCCESS;
+}
+
+/*******************************************************************************
+ * [Function Name]	: RTC_getSecondOfWeek
+ * [Description]	: Get seconds passed since Monday 00:00:00
+ * [Args]			: N/A
+ * [Returns]		: Second of the week, 0 .. 604799
+ *******************************************************************************/
+uint32 RTC_getSecondOfWeek(void){
+	uint8 sreg = SREG;						/* Save interrupt state */
+	cli();									/* Read 32 bits value atomically */
+	uint32 second = g_secondOfWeek;			/* Copy current second */
+	SREG = sreg;							/* Restore interrupt state */
+	return second;
+}
+
+/*******************************************************************************
+ * [Function Name]	: RTC_getTime
+ * [Description]	: Get current time of the week
+ * [Args]
+ * 		[OUT] RTC_TimeType * a_time_Ptr
+ * 					: Variable to read time into
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void RTC_getTime(RTC_TimeType *a_time_Ptr){
+	uint32 second = RTC_getSecondOfWeek();			/* Current second of week */
+	uint32 secondOfDay = second % 86400UL;			/* Second of current day */
+	a_time_Ptr->weekday = second / 86400UL;
+	a_time_Ptr->hour = secondOfDay / 3600;
+	a_time_Ptr->minute = (secondOfDay % 3600) / 60;
+	a_time_Ptr->second = secondOfDay % 60;
+}
+
+/*******************************************************************************
+ * [Function Name]	: RTC_isSet
+ * [Description]	: Check if time was set since power up, a watchdog reset keeps it
+ * [Args]			: N/A
+ * [Returns]		: TRUE if time is valid
+ *******************************************************************************/
+bool RTC_isSet(void){
+	uint8 sreg = SREG;						/* Save interrupt state */
+	cli();									/* Read time and check together */
+	bool set = (g_timeCheck == ~g_secondOfWeek);
+	SREG = sreg;							/* Restore interrupt state */
+	return set;
+}
+
+/*******************************************************************************
+ * [Function Name]	: RTC_setCalibration
+ * [Description]	: Set clock rate correction and save it to external EEPROM
+ * [Args]
+ * 		[IN] signed short a_ppm
+ * 					: Correction in ppm, positive speeds clock up
+ *
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+uint8 RTC_setCalibration(sint16 a_ppm){
+	if (a_ppm > RTC_MAX_PPM || a_ppm < -RTC_MAX_PPM)				/* Reject correction larger than 1% */
+		return ERROR;
+
+	uint8 sreg = SREG;						/* Save interrupt state */
+	cli();									/* Update calibration atomically */
+	g_calibration = a_ppm;					/* Apply new calibration */
+	g_drift = 0;							/* Drop drift accumulated with old calibration */
+	SREG = sreg;							/* Restore interrupt state */
+
+	uint8 low = (uint8)a_ppm;				/* Calibration low byte */
+	uint8 high = (uint8)((uint16)a_ppm >> 8);	/* Calibration high byte */
+	if (EEPROM_writeByte(RTC_CALIBRATION_ADDRESS, low) &&
+		EEPROM_writeByte(RTC_CALIBRATION_ADDRESS+1, high) &&
+		EEPROM_writeByte(RTC_CALIBRATION_ADDRESS+2, (uint8)~(low ^ high)))
+		return SUCCESS;
+	return ERROR;
+}
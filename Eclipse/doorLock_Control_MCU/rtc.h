@@ -0,0 +1,121 @@
+ /******************************************************************************
+ *
+ * 		Module: Real Time Clock
+ *
+ *	 File Name: rtc.h
+ *
+ * Description: Header file for software real time clock
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef RTC_H_
+#define RTC_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+#include "timers.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define RTC_PPM_PER_TICK		(1000000UL / TIMER1_TICKS_PER_SECOND)	/* One timer 1 tick is 8 ppm of a second	*/
+#define RTC_MAX_PPM				10000		/* Largest calibration accepted					*/
+#define RTC_SECONDS_PER_WEEK	604800UL	/* Clock counts seconds of the week				*/
+#define RTC_CALIBRATION_ADDRESS	0x0010		/* Address to save calibration in memory (3 bytes)	*/
+
+/* Link commands handled by the RTC */
+#define RTC_SET_TIME_COMMAND	'@'			/* Followed by weekday, hour, minute, second	*/
+#define RTC_CALIBRATE_COMMAND	'^'			/* Followed by ppm low byte, ppm high byte		*/
+
+/*******************************************************************************
+ *						Structures & Unions	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Structure Name]	: RTC_TimeType
+ * [Description]	: Struct holding time of the week
+ *******************************************************************************/
+typedef struct
+{
+	uint8 weekday;		/* Day of week, 0 = Monday .. 6 = Sunday */
+	uint8 hour;			/* Hour of day, 0 .. 23 */
+	uint8 minute;		/* Minute of hour, 0 .. 59 */
+	uint8 second;		/* Second of minute, 0 .. 59 */
+}RTC_TimeType;
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: RTC_init
+ * [Description]	: Load calibration from external EEPROM and start counting seconds
+ * [Args]
+ * 		[IN] bool a_keepTime
+ * 					: TRUE after a watchdog reset, time set before it goes on
+ * 					  from last counted second (late by reset and start up time)
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void RTC_init(bool a_keepTime);
+
+/*******************************************************************************
+ * [Function Name]	: RTC_setTime
+ * [Description]	: Set current time of the week
+ * [Args]
+ * 		[IN] const RTC_TimeType * a_time_Ptr
+ * 					: Time to set clock to
+ *
+ * [Returns]		: Operation success/failure (failure on out of range time)
+ *******************************************************************************/
+uint8 RTC_setTime(const RTC_TimeType *a_time_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: RTC_getTime
+ * [Description]	: Get current time of the week
+ * [Args]
+ * 		[OUT] RTC_TimeType * a_time_Ptr
+ * 					: Variable to read time into
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void RTC_getTime(RTC_TimeType *a_time_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: RTC_getSecondOfWeek
+ * [Description]	: Get seconds passed since Monday 00:00:00
+ * [Args]			: N/A
+ * [Returns]		: Second of the week, 0 .. 604799
+ *******************************************************************************/
+uint32 RTC_getSecondOfWeek(void);
+
+/*******************************************************************************
+ * [Function Name]	: RTC_isSet
+ * [Description]	: Check if time was set since power up, a watchdog reset keeps it
+ * [Args]			: N/A
+ * [Returns]		: TRUE if time is valid
+ *******************************************************************************/
+bool RTC_isSet(void);
+
+/*******************************************************************************
+ * [Function Name]	: RTC_setCalibration
+ * [Description]	: Set clock rate correction and save it to external EEPROM
+ * [Args]
+ * 		[IN] signed short a_ppm
+ * 					: Correction in ppm, positive speeds clock up
+ *
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+uint8 RTC_setCalibration(sint16 a_ppm);
+
+#endif /* RTC_H_ */
@@ -0,0 +1,195 @@
+/******************************************************************************
+ *
+ * 		Module: Access Schedule
+ *
+ *	 File Name: schedule.c
+ *
+ * Description: Source file for weekly door access schedule
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "schedule.h"
+#include "external_eeprom.h"
+#include "provision.h"
+
+/* Schedules must fit between their address and the provisioning record */
+STATIC_ASSERT(SCHEDULE_ADDRESS + SCHEDULE_GROUPS * SCHEDULE_GROUP_SIZE <= PROVISION_ADDRESS, schedule_overlaps_password);
+
+/* Changed groups are tracked in one byte */
+STATIC_ASSERT(SCHEDULE_GROUPS <= 8, too_many_schedule_groups);
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+/* One bit per 15 minutes slot of the week, slot 0 is Monday 00:00 */
+static uint8 g_schedule[SCHEDULE_GROUPS][SCHEDULE_GROUP_SIZE];
+
+static uint8 g_dirtyGroups;					/* Bit per group changed but not saved yet */
+static uint8 g_flushByte;					/* Next byte of first dirty group to compare with memory */
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_init
+ * [Description]	: Load schedules of all groups from external EEPROM
+ *
+ * 					  Erased memory reads 0xFF so a group never configured
+ * 					  allows access at any time. A group that can not be read
+ * 					  denies access at all times.
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void SCHEDULE_init(void){
+	for (uint8 group = 0; group < SCHEDULE_GROUPS; group++){
+		uint8 tries = SCHEDULE_READ_TRIES;						/* Reads left before giving up */
+		while (!EEPROM_readBlock(SCHEDULE_ADDRESS + group*SCHEDULE_GROUP_SIZE, g_schedule[group], SCHEDULE_GROUP_SIZE))
+			if (0 == --tries){									/* Memory failure */
+				for (uint8 i = 0; i < SCHEDULE_GROUP_SIZE; i++)
+					g_schedule[group][i] = 0;					/* Fail closed, never open on a memory failure */
+				break;
+			}
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_clear
+ * [Description]	: Deny access to a group at all times, saved by SCHEDULE_flush
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to clear
+ *
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+uint8 SCHEDULE_clear(uint8 a_group){
+	if (a_group >= SCHEDULE_GROUPS)
+		return ERROR;
+	for (uint8 i = 0; i < SCHEDULE_GROUP_SIZE; i++)
+		g_schedule[a_group][i] = 0;
+	SET_BIT(g_dirtyGroups, a_group);							/* Save group */
+	g_flushByte = 0;											/* Compare changed group from its start */
+	return SUCCESS;
+}
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_allow
+ * [Description]	: Add an access window to a group on selected days, saved by
+ * 					  SCHEDULE_flush. A window ending before it starts runs past
+ * 					  midnight into next day, Sunday wraps to Monday.
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to add window to
+ * 		[IN] unsigned char a_days
+ * 					: Days mask, bit 0 = Monday .. bit 6 = Sunday
+ * 		[IN] unsigned char a_startHour, a_startMinute
+ * 					: Window start, rounded down to 15 minutes
+ * 		[IN] unsigned char a_endHour, a_endMinute
+ * 					: Window end (excluded), rounded up to 15 minutes, 24:00 is end of day
+ *
+ * [Returns]		: Operation success/failure (failure on out of range arguments
+ * 					  or a window starting and ending in same slot)
+ *******************************************************************************/
+uint8 SCHEDULE_allow(uint8 a_group, uint8 a_days, uint8 a_startHour, uint8 a_startMinute, uint8 a_endHour, uint8 a_endMinute){
+	if (a_group >= SCHEDULE_GROUPS || a_startHour > 23 || a_startMinute > 59 || a_endMinute > 59 ||
+		a_endHour > 24 || (24 == a_endHour && a_endMinute != 0))
+		return ERROR;											/* Reject out of range window */
+
+	uint8 start = a_startHour*4 + a_startMinute/15;				/* First slot of window */
+	uint8 end = a_endHour*4 + (a_endMinute+14)/15;				/* First slot after window */
+	if (start == end)
+		return ERROR;											/* Reject empty window */
+	uint8 length = (end > start) ? end - start : SCHEDULE_SLOTS_PER_DAY - start + end;	/* Slots in window */
+
+	/* Compile window into bitmap once, so checking access is a single bit test */
+	for (uint8 day = 0; day < 7; day++){
+		if (BIT_IS_CLEAR(a_days, day))							/* Window not applied on this day */
+			continue;
+		uint16 slot = day*SCHEDULE_SLOTS_PER_DAY + start;		/* Slot of the week window starts in */
+		for (uint8 i = 0; i < length; i++){
+			SET_BIT(g_schedule[a_group][slot >> 3], (slot & 7));
+			if (++slot == SCHEDULE_SLOTS_PER_WEEK)				/* Sunday night runs into Monday */
+				slot = 0;
+		}
+	}
+	SET_BIT(g_dirtyGroups, a_group);							/* Save group */
+	g_flushByte = 0;											/* Compare changed group from its start */
+	return SUCCESS;
+}
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_isAllowed
+ * [Description]	: Check if a group has access at a second of the week
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to check
+ * 		[IN] unsigned long a_secondOfWeek
+ * 					: Time to check as seconds since Monday 00:00:00
+ *
+ * [Returns]		: TRUE if access is allowed
+ *******************************************************************************/
+bool SCHEDULE_isAllowed(uint8 a_group, uint32 a_secondOfWeek){
+	uint16 slot = a_secondOfWeek / SCHEDULE_SLOT_SECONDS;		/* Slot of the week, 0 .. 671 */
+	return BIT_IS_SET(g_schedule[a_group][slot >> 3], (slot & 7)) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_isUnrestricted
+ * [Description]	: Check if a group has access at all times of the week
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to check
+ *
+ * [Returns]		: TRUE if no slot of the week is denied
+ *******************************************************************************/
+bool SCHEDULE_isUnrestricted(uint8 a_group){
+	for (uint8 i = 0; i < SCHEDULE_GROUP_SIZE; i++)
+		if (g_schedule[a_group][i] != 0xFF)
+			return FALSE;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_flush
+ * [Description]	: Save changed groups to external EEPROM one write at a time
+ *
+ * 					  Bytes are compared with memory until one differs, it is
+ * 					  written and function returns. Every write takes 10ms,
+ * 					  caller repeats while serving watchdog.
+ * [Args]			: N/A
+ * [Returns]		: TRUE while changes are left to save, FALSE once saved or
+ * 					  on a memory failure, which is retried on next call
+ *******************************************************************************/
+bool SCHEDULE_flush(void){
+	uint8 byte;												/* Byte currently saved in memory */
+	for (uint8 group = 0; group < SCHEDULE_GROUPS; group++){
+		if (BIT_IS_CLEAR(g_dirtyGroups, group))				/* Group saved */
+			continue;
+		uint16 address = SCHEDULE_ADDRESS + group*SCHEDULE_GROUP_SIZE;	/* Address of group in memory */
+		for (; g_flushByte < SCHEDULE_GROUP_SIZE; g_flushByte++){
+			if (EEPROM_readByte(address + g_flushByte, &byte) && byte == g_schedule[group][g_flushByte])
+				continue;									/* Skip unchanged bytes */
+			if (!EEPROM_writeByte(address + g_flushByte, g_schedule[group][g_flushByte]))
+				return FALSE;								/* Memory failure, stay dirty */
+			g_flushByte++;
+			return TRUE;									/* One write per call */
+		}
+		CLEAR_BIT(g_dirtyGroups, group);					/* Whole group compared */
+		g_flushByte = 0;
+	}
+	return FALSE;
+}
@@ -0,0 +1,134 @@
+ /******************************************************************************
+ *
+ * 		Module: Access Schedule
+ *
+ *	 File Name: schedule.h
+ *
+ * Description: Header file for weekly door access schedule
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef SCHEDULE_H_
+#define SCHEDULE_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#ifndef SCHEDULE_GROUPS
+#define SCHEDULE_GROUPS			1			/* Number of user groups with own schedule		*/
+#endif
+
+#define SCHEDULE_SLOT_SECONDS	900			/* Schedule resolution: 15 minutes				*/
+#define SCHEDULE_SLOTS_PER_DAY	96			/* 24 hours of 15 minutes slots					*/
+#define SCHEDULE_SLOTS_PER_WEEK	(7 * SCHEDULE_SLOTS_PER_DAY)	/* Slots of the week			*/
+#define SCHEDULE_GROUP_SIZE		84			/* 7 days * 96 slots / 8 bits per byte			*/
+#define SCHEDULE_ADDRESS		0x0020		/* Address to save schedules in memory			*/
+#define SCHEDULE_READ_TRIES		3			/* Reads of a group before it is taken as failed	*/
+
+/* Policy while time is not set since power up, 0 denies opening to a group that has
+ * any access window configured, 1 lets every group in until time is set */
+#ifndef SCHEDULE_ALLOW_WITHOUT_CLOCK
+#define SCHEDULE_ALLOW_WITHOUT_CLOCK	0
+#endif
+
+/* Link command handled by the schedule */
+#define SCHEDULE_COMMAND		'&'			/* Followed by group, days mask, start hour, start minute, end hour, end minute */
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_init
+ * [Description]	: Load schedules of all groups from external EEPROM
+ *
+ * 					  Erased memory reads 0xFF so a group never configured
+ * 					  allows access at any time. A group that can not be read
+ * 					  denies access at all times.
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void SCHEDULE_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_clear
+ * [Description]	: Deny access to a group at all times, saved by SCHEDULE_flush
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to clear
+ *
+ * [Returns]		: Operation success/failure
+ *******************************************************************************/
+uint8 SCHEDULE_clear(uint8 a_group);
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_allow
+ * [Description]	: Add an access window to a group on selected days, saved by
+ * 					  SCHEDULE_flush. A window ending before it starts runs past
+ * 					  midnight into next day, Sunday wraps to Monday.
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to add window to
+ * 		[IN] unsigned char a_days
+ * 					: Days mask, bit 0 = Monday .. bit 6 = Sunday
+ * 		[IN] unsigned char a_startHour, a_startMinute
+ * 					: Window start, rounded down to 15 minutes
+ * 		[IN] unsigned char a_endHour, a_endMinute
+ * 					: Window end (excluded), rounded up to 15 minutes, 24:00 is end of day
+ *
+ * [Returns]		: Operation success/failure (failure on out of range arguments
+ * 					  or a window starting and ending in same slot)
+ *******************************************************************************/
+uint8 SCHEDULE_allow(uint8 a_group, uint8 a_days, uint8 a_startHour, uint8 a_startMinute, uint8 a_endHour, uint8 a_endMinute);
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_isAllowed
+ * [Description]	: Check if a group has access at a second of the week
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to check
+ * 		[IN] unsigned long a_secondOfWeek
+ * 					: Time to check as seconds since Monday 00:00:00
+ *
+ * [Returns]		: TRUE if access is allowed
+ *******************************************************************************/
+bool SCHEDULE_isAllowed(uint8 a_group, uint32 a_secondOfWeek);
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_isUnrestricted
+ * [Description]	: Check if a group has access at all times of the week
+ * [Args]
+ * 		[IN] unsigned char a_group
+ * 					: Group to check
+ *
+ * [Returns]		: TRUE if no slot of the week is denied
+ *******************************************************************************/
+bool SCHEDULE_isUnrestricted(uint8 a_group);
+
+/*******************************************************************************
+ * [Function Name]	: SCHEDULE_flush
+ * [Description]	: Save changed groups to external EEPROM one write at a time
+ *
+ * 					  Bytes are compared with memory until one differs, it is
+ * 					  written and function returns. Every write takes 10ms,
+ * 					  caller repeats while serving watchdog.
+ * [Args]			: N/A
+ * [Returns]		: TRUE while changes are left to save, FALSE once saved or
+ * 					  on a memory failure, which is retried on next call
+ *******************************************************************************/
+bool SCHEDULE_flush(void);
+
+#endif /* SCHEDULE_H_ */
@@ -1,51 +0,0 @@
- /******************************************************************************
- *
- * 		Module: Common - Platform Types Abstraction
- *
- * 	 File Name: std_types.h
- *
- * Description: Standard types for AVR
- *
- * 		Author: Mohamed Mahfouz
- *
- * 	Created on: Nov 20, 2020
- *
- *******************************************************************************/
-
-#ifndef STD_TYPES_H_
-#define STD_TYPES_H_
-
-/*******************************************************************************
- *                      Preprocessor Macros                                    *
- *******************************************************************************/
-
-/* Boolean Data Type */
-typedef unsigned char bool;
-
-/* Boolean Values */
-#ifndef FALSE
-#define FALSE       (0u)
-#endif
-#ifndef TRUE
-#define TRUE        (1u)
-#endif
-
-/* Bit values */
-#define HIGH        (1u)
-#define LOW         (0u)
-
-/* NULL definition */
-#define NULL ((void *)0)
-											  /*					 Integer Limits						 */
-typedef unsigned char         uint8;          /*           				 0 .. 255             			 */
-typedef signed char           sint8;          /*        			  -128 .. 127            			 */
-typedef unsigned short        uint16;         /*           				 0 .. 65,535           			 */
-typedef signed short          sint16;         /*      			   -32,768 .. 32,767          			 */
-typedef unsigned long         uint32;         /*           				 0 .. 4,294,967,295      		 */
-typedef signed long           sint32;         /* 			-2,147,483,648 .. 2,147,483,647     		 */
-typedef unsigned long long    uint64;         /*       					 0 .. 18,446,744,073,709,551,615 */
-typedef signed long long      sint64;		  /* -9,223,372,036,854,775808 .. 9,223,372,036,854,775,807	 */
-typedef float                 float32;
-typedef double                float64;
-
-#endif /* STD_TYPE_H_ */
@@ -5,31 +5,31 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../MCU.c \
+../glyphs.c \
 ../keypad.c \
 ../lcd.c \
-../timers.c \
-../usart.c 
+../messages.c 
 
 OBJS += \
 ./MCU.o \
+./glyphs.o \
 ./keypad.o \
 ./lcd.o \
-./timers.o \
-./usart.o 
+./messages.o 
 
 C_DEPS += \
 ./MCU.d \
+./glyphs.d \
 ./keypad.d \
 ./lcd.d \
-./timers.d \
-./usart.d 
+./messages.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 %.o: ../%.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
-	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -c -o "$@" "$<"
+	avr-gcc -Wall -g2 -gstabs -I"../../drivers" -Os -flto -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
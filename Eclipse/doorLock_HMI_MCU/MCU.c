@@ -17,23 +17,54 @@
  *******************************************************************************/
 
 #include "MCU.h"
+#include <avr/pgmspace.h>
 
-/*******************************************************************************
- *                      Global Variables                              	   	   *
- *******************************************************************************/
-
-uint8 g_password[PASSWORD_LENGTH];		/* Variable to hold input password */
+/* A full password and its confirming key must fit in key type-ahead */
+STATIC_ASSERT(KEYPAD_EVENT_QUEUE_SIZE - 1 >= PASSWORD_LENGTH, keypad_queue_shorter_than_password);
 
 /*******************************************************************************
  *                    	Function Prototypes                            		   *
  *******************************************************************************/
 
 void MCU_init(void);					/* Function to initiate MCU */
-void resetPassword(void);				/* Function to reset password container */
 void getPassword(void);					/* Function to get password from user */
 void getAndSendPassword(void);			/* Function to get password and send it to control MCU */
-void raiseError(void);					/* Function to Start error actions */
 void unlockSystem(void);				/* Function to unlock system */
+uint8 getKey(void);						/* Function to wait for a key while serving watchdog */
+void getKeyEvent(KEYPAD_EventType *a_event_Ptr);	/* Function to wait for a key event while serving watchdog */
+void holdDelay(uint16 a_time);			/* Function to delay while serving watchdog */
+void holdWithBar(uint32 a_start, uint8 a_second, uint8 a_lastSecond);	/* Function to wait while drawing time bar */
+FSM_StateType bootSystem(void);			/* Function to bring up LCD and link together on cold start */
+uint8 receiveResult(void);				/* Function to receive action result skipping late handshake answers */
+FSM_EventType checkPassword(MESSAGE_Id a_prompt);	/* Function to get password checked by control MCU */
+uint16 getNumber(uint8 a_digits);		/* Function to get a decimal number from user */
+bool sendServiceCommand(void);			/* Function to get a service command from user and send it */
+
+/* State activities, each runs until an event ends its state */
+FSM_EventType setupNewState(void);
+FSM_EventType setupConfirmState(void);
+FSM_EventType readyState(void);
+FSM_EventType changeCheckState(void);
+FSM_EventType openCheckState(void);
+FSM_EventType serviceCheckState(void);
+FSM_EventType unlockingState(void);
+FSM_EventType lockedState(void);
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+/* Activity of every state of fsm.def, kept in flash */
+static const FSM_ActivityType g_activities[FSM_STATES_COUNT] PROGMEM = {
+	[FSM_STATE_SETUP_NEW] = setupNewState,
+	[FSM_STATE_SETUP_CONFIRM] = setupConfirmState,
+	[FSM_STATE_READY] = readyState,
+	[FSM_STATE_CHANGE_CHECK] = changeCheckState,
+	[FSM_STATE_OPEN_CHECK] = openCheckState,
+	[FSM_STATE_SERVICE_CHECK] = serviceCheckState,
+	[FSM_STATE_UNLOCKING] = unlockingState,
+	[FSM_STATE_LOCKED] = lockedState
+};
 
 /*******************************************************************************
  *                      Function Definitions                                   *
@@ -41,76 +72,267 @@ void unlockSystem(void);				/* Function to unlock system */
 
 int main(void){
 
-	g_password[PASSWORD_LENGTH-1] = '\0';		/* Set last character in password string to NULL terminator */
-	uint8 setup = TRUE;							/* Variable for checking of setup state on MCU*/
-	uint8 changePass = FALSE;					/* Variable for checking of changing password state on MCU*/
-	uint8 openDoor = FALSE;						/* Variable for checking of opening door state on MCU*/
-	uint8 actionSymbol = 0;						/* Variable to hold action to be taken next */
+	FSM_StateType state;						/* Variable to hold current state */
 	MCU_init();									/* Initiate MCU */
-	LCD_displayStringOnNewScreen("Welcome to your door lock system");		/* Display welcome message */
-	_delay_ms(2000);							/* Delay to message display */
+	state = bootSystem();						/* Ask control MCU for its state, also after a watchdog reset as it went on meanwhile */
 	while(1){
-		while(setup){														/* Enter setup state */
-			LCD_displayStringOnNewScreen("Please set up your pass: ");		/* Display password setup message */
-			getAndSendPassword();											/* Get and send password to control MCU */
-			LCD_displayStringOnNewScreen("Please confirm pass: ");			/* Display password confirmation message */
-			getAndSendPassword();											/* Get and send password to control MCU */
-			if (ACTION_SUCCESS == USART_receiveByte()){						/* If password set action succeeded */
-				setup = FALSE;												/* Disable setup state */
-				LCD_displayStringOnNewScreen("New password set");			/* Display password set message */
-				_delay_ms(2000);											/* Delay to message display */
-				break;														/* Exit active state */
-			}
-			else{															/* If passwords did not match */
-				LCD_displayStringOnNewScreen("Passwords do not match");		/* Display passwords don't match error message */
-				_delay_ms(2000);											/* Delay to message display */
-			}
+		FSM_ActivityType activity = (FSM_ActivityType)pgm_read_word(&g_activities[state]);	/* Activity of state */
+		FSM_StateType next = FSM_next(state, activity());	/* Run state until an event ends it, then look up next state */
+		if (FSM_STATE_NONE != next)				/* Ignored events run state again */
+			state = next;
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: setupNewState
+ * [Description]	: Get new password from user and send it to control MCU
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType setupNewState(void){
+	MESSAGES_displayOnNewScreen(MESSAGE_SET_PASS);				/* Display password setup message */
+	getAndSendPassword();										/* Get and send password to control MCU */
+	return FSM_EVENT_ENTERED;
+}
+
+/*******************************************************************************
+ * [Function Name]	: setupConfirmState
+ * [Description]	: Get new password again and show if both matched
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType setupConfirmState(void){
+	MESSAGES_displayOnNewScreen(MESSAGE_CONFIRM_PASS);			/* Display password confirmation message */
+	getAndSendPassword();										/* Get and send password to control MCU */
+	if (ACTION_SUCCESS == receiveResult()){						/* If password set action succeeded */
+		MESSAGES_displayOnNewScreen(MESSAGE_PASS_SET);			/* Display password set message */
+		holdDelay(MESSAGE_DELAY);								/* Delay to message display */
+		return FSM_EVENT_SUCCESS;
+	}
+	MESSAGES_displayOnNewScreen(MESSAGE_PASS_MISMATCH);			/* Display passwords don't match error message */
+	holdDelay(MESSAGE_DELAY);									/* Delay to message display */
+	return FSM_EVENT_FAIL;
+}
+
+/*******************************************************************************
+ * [Function Name]	: readyState
+ * [Description]	: Show available actions and send the one user chose, a long
+ * 					  press of KEY_SERVICE opens service menu
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType readyState(void){
+	KEYPAD_EventType event;												/* Variable to hold key event */
+	uint8 actionSymbol;													/* Variable to hold action to be taken next */
+	MESSAGES_displayOnNewScreen(MESSAGE_MENU_CHANGE);					/* Display available actions message part 1 */
+	MESSAGES_displayRowColumn(1, 0, MESSAGE_MENU_OPEN);					/* Display available actions message part 2 */
+
+	do{																	/* Keep looping while checking for user input */
+		PROFILER_MEASURE(PROFILER_SITE_KEYPAD, getKeyEvent(&event));	/* Get user input */
+		if (KEYPAD_EVENT_LONG_PRESS == event.kind && KEY_SERVICE == event.key){	/* Service menu chosen */
+			USART_sendByte(LINK_SERVICE);								/* Control MCU asks for password first */
+			return FSM_EVENT_SERVICE;
 		}
+		actionSymbol = (KEYPAD_EVENT_PRESS == event.kind) ? event.key : KEYPAD_NO_KEY;	/* Only presses choose actions */
+		if (KEY_3X4_ALTERNATE == actionSymbol)							/* 3x4 keypads have no '-' key */
+			actionSymbol = '-';											/* Treat it as open door action */
+#if PROFILER_ENABLED
+		if (PROFILER_REPORT_KEY == actionSymbol)						/* If profiler report requested */
+			PROFILER_report();											/* Send profiler report */
+#endif
+	}while('*' != actionSymbol && '-' != actionSymbol);					/* Wait until input received is an action */
 
-		while(changePass || openDoor){										/* Enter change pass and open door states */
-			LCD_displayStringOnNewScreen(openDoor ? "Please enter pass: " : "Please enter old pass: ");		/* Display password request message */
-			getAndSendPassword();											/* Get and send password to control MCU */
-			uint8 result = USART_receiveByte();								/* Receive action result */
-			if (ACTION_SUCCESS == result){									/* If action success code received */
-				if (openDoor){												/* If active state is open door state */
-					openDoor = FALSE;										/* Disable open door state */
-					unlockSystem();											/* Unlock system */
-				}
-				else{														/* If active state is change pass state */
-					changePass = FALSE;										/* Disable change pass state */
-					setup = TRUE;											/* Disable setup state */
-				}
-				break;														/* Exit active state */
-			}
-			else if (ACTION_ERROR == result){								/* If error code received */
-				changePass = FALSE;											/* Disable change pass state */
-				openDoor = FALSE;											/* Disable open door state */
-				raiseError();												/* Start error actions */
-				break;														/* Exit active state */
-			}
-			else{															/* If action fail code received */
-				LCD_displayStringOnNewScreen("wrong password, Please try again");		/* Display wrong password message */
-				_delay_ms(2000);											/* Delay to message display */
-			}
+	USART_sendByte(actionSymbol);										/* Send action to control MCU */
+	return ('*' == actionSymbol) ? FSM_EVENT_CHANGE : FSM_EVENT_OPEN;
+}
+
+/*******************************************************************************
+ * [Function Name]	: changeCheckState
+ * [Description]	: Get old password before changing it
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType changeCheckState(void){
+	return checkPassword(MESSAGE_ENTER_OLD_PASS);
+}
+
+/*******************************************************************************
+ * [Function Name]	: openCheckState
+ * [Description]	: Get password before opening door
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType openCheckState(void){
+	return checkPassword(MESSAGE_ENTER_PASS);
+}
+
+/*******************************************************************************
+ * [Function Name]	: serviceCheckState
+ * [Description]	: Get password, then one clock or schedule command from service
+ * 					  menu and show its result
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType serviceCheckState(void){
+	FSM_EventType event = checkPassword(MESSAGE_SERVICE_PASS);	/* Only password holder sets clock and schedule */
+	if (FSM_EVENT_SUCCESS != event)
+		return event;
+	if (!sendServiceCommand()){									/* Menu left without a command */
+		USART_sendByte(LINK_SERVICE);							/* Control MCU stops waiting for one */
+		return FSM_EVENT_SUCCESS;
+	}
+	if (ACTION_SUCCESS == receiveResult())						/* If command was applied */
+		MESSAGES_displayOnNewScreen(MESSAGE_SERVICE_SAVED);		/* Display saved message */
+	else
+		MESSAGES_displayOnNewScreen(MESSAGE_SERVICE_REJECTED);	/* Display value out of range message */
+	holdDelay(MESSAGE_DELAY);									/* Delay to message display */
+	return FSM_EVENT_SUCCESS;
+}
+
+/*******************************************************************************
+ * [Function Name]	: sendServiceCommand
+ * [Description]	: Show service menu and send command user filled in, values are
+ * 					  checked by control MCU
+ *
+ * 					  1 Time		day 1-7 (Monday is 1) and HH:MM	-> '@'
+ * 					  2 Window	daily HH:MM-HH:MM, 24:00 is end of day	-> '&'
+ * 					  3 Clear		deny access at all times until a window is added -> '&'
+ * 					  4 Trim		1 speeds clock up, 2 slows it down, by ppm -> '^'
+ *
+ * 					  Any other key leaves menu.
+ * [Args]			: N/A
+ * [Returns]		: TRUE if a command was sent, FALSE if menu was left
+ *******************************************************************************/
+bool sendServiceCommand(void){
+	uint8 params[6] = {SERVICE_GROUP, 0, 0, 0, 0, 0};		/* Command parameters, schedule ones by default */
+	uint8 command = SCHEDULE_COMMAND;						/* Command to send */
+	uint8 count = 6;										/* Number of parameters */
+	MESSAGES_displayOnNewScreen(MESSAGE_SERVICE_MENU);		/* Display service menu part 1 */
+	MESSAGES_displayRowColumn(1, 0, MESSAGE_SERVICE_MENU_MORE);	/* Display service menu part 2 */
+
+	switch (getKey()){
+	case '1':												/* Set time of the week */
+		MESSAGES_displayOnNewScreen(MESSAGE_SERVICE_TIME);
+		LCD_goToRowColumn(NUMBER_OF_LCD_ROWS-1, 0);			/* Values are typed on last row */
+		params[0] = getNumber(1) - 1;						/* Monday is 0, day 0 wraps out of range */
+		LCD_displayCharacter(' ');
+		params[1] = getNumber(2);							/* Hour */
+		LCD_displayCharacter(':');
+		params[2] = getNumber(2);							/* Minute */
+		params[3] = 0;										/* Second */
+		command = RTC_SET_TIME_COMMAND;
+		count = 4;
+		break;
+	case '2':												/* Add daily access window */
+		MESSAGES_displayOnNewScreen(MESSAGE_SERVICE_WINDOW);
+		LCD_goToRowColumn(NUMBER_OF_LCD_ROWS-1, 0);			/* Values are typed on last row */
+		params[1] = SERVICE_ALL_DAYS;
+		for (uint8 i = 2; i < 6; i++){						/* Start hour, start minute, end hour, end minute */
+			params[i] = getNumber(2);
+			if (i != 5)
+				LCD_displayCharacter((3 == i) ? '-' : ':');
 		}
+		break;
+	case '3':												/* Clear schedule, days mask 0 */
+		break;
+	case '4':{												/* Set clock calibration */
+		MESSAGES_displayOnNewScreen(MESSAGE_SERVICE_TRIM);
+		uint8 direction = getKey();							/* Speed clock up or slow it down */
+		if ('1' != direction && '2' != direction)
+			return FALSE;
+		MESSAGES_displayOnNewScreen(MESSAGE_SERVICE_PPM);
+		LCD_goToRowColumn(NUMBER_OF_LCD_ROWS-1, 0);			/* Values are typed on last row */
+		sint16 ppm = getNumber(4);							/* Correction size */
+		if ('2' == direction)								/* Positive correction speeds clock up */
+			ppm = -ppm;
+		params[0] = (uint8)ppm;								/* Low byte */
+		params[1] = (uint8)((uint16)ppm >> 8);				/* High byte */
+		command = RTC_CALIBRATE_COMMAND;
+		count = 2;
+		break;
+	}
+	default:												/* Menu left */
+		return FALSE;
+	}
 
-		if (setup)															/* If setup action enabled */
-			continue;														/* Skip rest and go to setupS action*/
+	USART_sendByte(command);								/* Send command and its parameters */
+	for (uint8 i = 0; i < count; i++)
+		USART_sendByte(params[i]);
+	return TRUE;
+}
 
-		LCD_displayStringOnNewScreen("X Change pass");						/*Display available actions message part 1 */
-		LCD_displayStringRowColumn(1, 0, "- Open door");					/*Display available actions message part 2 */
+/*******************************************************************************
+ * [Function Name]	: unlockingState
+ * [Description]	: Show door open cycle
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType unlockingState(void){
+	unlockSystem();												/* Unlock system */
+	return FSM_EVENT_TIMEOUT;
+}
 
-		do{																	/* Keep looping while checking for user input */
-			actionSymbol = KEYPAD_getPressed();								/* Get user input */
-		}while('*' != actionSymbol && '-' != actionSymbol);					/* Wait until input received is an action */
+/*******************************************************************************
+ * [Function Name]	: lockedState
+ * [Description]	: Show lockout countdown until control MCU ends lockout, time
+ * 					  left is queried from control MCU and drawn in between
+ * [Args]			: N/A
+ * [Returns]		: Event ending state
+ *******************************************************************************/
+FSM_EventType lockedState(void){
+	uint32 total = (uint32)LOCKOUT_SECONDS * TIMER1_TICKS_PER_SECOND;	/* Ticks of whole lockout */
+	uint32 now = TIMER1_now();									/* Current time stamp */
+	uint32 end = now + total;									/* Lockout end, corrected by control MCU answers */
+	uint32 nextQuery = now;										/* Time to send next status query */
+	sint32 left;												/* Ticks left until lockout end */
+	MESSAGES_displayOnNewScreen(MESSAGE_ERROR_LOCKED);			/* Display error message */
+	GLYPHS_drawIcon(0, 0, GLYPHS_ICON_LOCK);					/* Lock icon in front of message */
+	while(1){
+		now = TIMER1_now();
+		left = (sint32)(end - now);
+		uint8 symbol;											/* Symbol received */
+		if (USART_receiveSymbol(&symbol)){						/* Control MCU answered */
+			if (LINK_COUNTDOWN == symbol)						/* Lockout running, seconds left follow */
+				end = now + (uint32)USART_receiveByte() * TIMER1_TICKS_PER_SECOND;
+			else if (LINK_READY == symbol){						/* Lockout ended */
+				KEYPAD_flush();									/* Drop keys typed while locked */
+				return FSM_EVENT_TIMEOUT;
+			}
+		}
+		else if ((sint32)(now - nextQuery) >= 0){				/* Time to ask for status again */
+			USART_sendByte(LINK_STATUS);
+			nextQuery = now + STATUS_PERIOD;
+		}
+		GLYPHS_drawBar(NUMBER_OF_LCD_ROWS-1, 0, NUMBER_OF_LCD_COLS, (left > 0) ? (uint32)left : 0, total);	/* Show time left */
+		SUPERVISOR_kick();										/* Kick watchdog while locked */
+	}
+}
 
-		USART_sendByte(actionSymbol);										/* Send action to control MCU */
-		if ('*' == actionSymbol)											/* If change pass action received */
-			changePass = TRUE;												/* Enable change pass state */
-		else if ('-' == actionSymbol)										/* If open door action received */
-			openDoor = TRUE;												/* Enable open door state */
-		actionSymbol = 0;													/* Reset action symbol*/
+/*******************************************************************************
+ * [Function Name]	: checkPassword
+ * [Description]	: Get password, send it to control MCU and show its verdict
+ * [Args]
+ * 		[IN] MESSAGE_Id a_prompt
+ * 					: Message asking for password
+ *
+ * [Returns]		: Event of verdict
+ *******************************************************************************/
+FSM_EventType checkPassword(MESSAGE_Id a_prompt){
+	MESSAGES_displayOnNewScreen(a_prompt);						/* Display password request message */
+	getAndSendPassword();										/* Get and send password to control MCU */
+	uint8 result = receiveResult();								/* Receive action result */
+	if (ACTION_SUCCESS == result)								/* If action success code received */
+		return FSM_EVENT_SUCCESS;
+	if (ACTION_ERROR == result)									/* If error code received */
+		return FSM_EVENT_ERROR;
+	if (ACTION_DENIED == result){								/* If door opened outside access window */
+		MESSAGES_displayOnNewScreen(MESSAGE_ACCESS_DENIED);		/* Display access denied message */
+		holdDelay(MESSAGE_DELAY);								/* Delay to message display */
+		return FSM_EVENT_DENIED;
 	}
+	MESSAGES_displayOnNewScreen(MESSAGE_WRONG_PASS);			/* Display wrong password message */
+	holdDelay(MESSAGE_DELAY);									/* Delay to message display */
+	return FSM_EVENT_FAIL;
 }
 
 /*******************************************************************************
@@ -121,68 +343,69 @@ int main(void){
  *******************************************************************************/
 void MCU_init(void){
 
-	/*
-	 * Baud Rate		= BAUD_RATE_9600	-> set baud rate to 9600 bits per second
-	 * Character size	= EIGHT_BITS		-> Set data transfer size to 8 bits
-	 * Parity			= DISABLED			-> Disable parity bit
-	 * Stop bit			= ONE_BIT			-> Set only 1 stop bit
-	 */
-	Usart_ConfigType usart_configuration = {BAUD_RATE_9600, EIGHT_BITS, DISABLED, ONE_BIT};
-
-	/*
-	 * Initial value			= 0							-> Initial clock value
-	 * Top Value				= 31250						-> Max clock value
-	 * Waveform generation mode	= CLEAR_TIMER_COMPARE_ICR1	-> Clear timer compare mode
-	 * Clock prescaler			= FCPU_256					-> divide MCU clock by 256
-	 * Compare match output A	= NORMAL_OPERATION			-> Normal pin operation for OCR1A
-	 * Compare match output B	= NORMAL_OPERATION			-> Normal pin operation for OCR1B
-	 */
-	TIMERS_ConfigType timer_configuration = {0, 31250, CLEAR_TIMER_COMPARE_ICR1, FCPU_256, NORMAL_OPERATION, NORMAL_OPERATION};
+	/* Read reset cause and start watchdog supervisor */
+	SUPERVISOR_init();
 
 	/* Clear I-bit from status register to not detect interrupts */
 	cli();
 
-	/* Initialize LCD screen */
-	LCD_init();
+	/* Initiate profiler time base first if instrumentation is compiled in, boot is timed from here */
+	PROFILER_init();
+
+	/* Initiate USART communication protocol with compile-time configuration (9600 8N1) */
+	USART_initStatic();
 
-	/* Initiate USART communication protocol with provided configurations */
-	USART_init(&usart_configuration);
+	/* Initiate timer 1 as free running deadline timer with compile-time configuration (F_CPU/64) */
+	TIMER1_initStatic();
 
-	/* Initiate timer 1 with provided configurations */
-	TIMER1_init(&timer_configuration);
+	/* Start background keypad scanning on timer 1 */
+	KEYPAD_init();
+
+	/* Initialize LCD screen, drawn in background on timer 1 */
+	LCD_init();
 
 	/* Set I-bit in status register to detect interrupts */
 	sei();
 }
 
-/*******************************************************************************
- * [Function Name]	: resetPassword
- * [Description]	: Reset password array
- * [Args]			: N/A
- * [Returns]		: N/A
- *******************************************************************************/
-void resetPassword(void){
-	for(int i = 0; i < PASSWORD_LENGTH-1; i++)		/* Loop through password received */
-		g_password[i] = '*';						/* Set value to * */
-}
-
 /*******************************************************************************
  * [Function Name]	: getPassword
- * [Description]	: Get password from user
+ * [Description]	: Get password from user, streaming every digit to control MCU
+ * 					  as it is typed
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
 void getPassword(void){
+	KEYPAD_EventType event;											/* Variable to hold key event */
 	uint8 passwordIterator = 0;										/* Variable to iterate over password string */
-	while(passwordIterator != PASSWORD_LENGTH-1){					/* Loop until full password ready */
-		g_password[passwordIterator] = KEYPAD_getPressed() + '0';	/* Assign received input to password */
-		if (g_password[passwordIterator] >= '0' && g_password[passwordIterator] <= '9'){	/* Check if received character is valid */
+	while(1){														/* Loop until full password is confirmed */
+		PROFILER_MEASURE(PROFILER_SITE_KEYPAD, getKeyEvent(&event));	/* Get user input */
+		if (KEYPAD_takeOverflow()){									/* Keys typed ahead were lost on a full queue */
+			KEYPAD_flush();											/* Rest of type-ahead no longer follows typed order */
+			event.kind = KEYPAD_EVENT_LONG_PRESS;					/* Handle as quick clear, user types password again */
+			event.key = KEY_CLEAR_ENTRY;
+		}
+		if (KEYPAD_EVENT_PRESS == event.kind && event.key >= '0' && event.key <= '9'){	/* Check if received character is valid */
+			if (passwordIterator == PASSWORD_LENGTH-1)				/* Ignore digits after full password */
+				continue;
+			USART_sendByte(event.key);								/* Stream digit to control MCU as it is typed */
 			passwordIterator++;										/* Increment password iterator */
 			LCD_displayCharacter('*');								/* Display * in place of input character */
-			_delay_ms(500);											/* Delay to avoid duplicate input */
+		}
+		else if (KEYPAD_EVENT_PRESS == event.kind && ('=' == event.key || KEY_3X4_ALTERNATE == event.key)){	/* Completed character */
+			if (passwordIterator == PASSWORD_LENGTH-1){				/* Only accept full password */
+				USART_sendByte(PASSWORD_END);						/* Confirm password, verdict follows at once */
+				break;
+			}
+		}
+		else if (KEYPAD_EVENT_LONG_PRESS == event.kind && KEY_CLEAR_ENTRY == event.key){	/* Quick clear of typed digits */
+			USART_sendByte(PASSWORD_CLEAR);							/* Control MCU drops streamed digits too */
+			while (passwordIterator != 0){							/* Erase every displayed * */
+				passwordIterator--;
+				LCD_eraseCharacter();								/* Blank last * and step back over it */
+			}
 		}
 	}
-	while ('=' != KEYPAD_getPressed());								/* Wait for completed character */
 }
 
 /*******************************************************************************
@@ -192,38 +415,184 @@ void getPassword(void){
  * [Returns]		: N/A
  *******************************************************************************/
 void getAndSendPassword(void){
-	getPassword();						/* Get password from user */
-	USART_sendString(g_password);		/* Send password to control MCU */
-	resetPassword();					/* Reset password array */
+	PROFILER_MEASURE(PROFILER_SITE_PASSWORD, getPassword());	/* Get password from user while streaming it */
 }
 
 /*******************************************************************************
- * [Function Name]	: raiseError
- * [Description]	: Start MCU error actions
+ * [Function Name]	: unlockSystem
+ * [Description]	: Start MCU unlocking actions
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
-void raiseError(void){
-	TIMER1_start();											/* Start timer 1 */
-	LCD_displayStringOnNewScreen("     ERROR!     ");		/* Display error message part 1 */
-	LCD_displayStringRowColumn(1, 0, " SYSTEM LOCKED! ");	/* Display error message part 2 */
-	while(g_timePassed <= 60);								/* Wait for 1 minute */
-	TIMER1_stop();											/* Stop timer 1 */
+void unlockSystem(void){
+	TIMER1_start();									/* Start timer 1 */
+	uint32 start = TIMER1_now();					/* Time unlock cycle started */
+	MESSAGES_displayOnNewScreen(MESSAGE_DOOR_OPENING);	/* Display door opening message */
+	GLYPHS_drawIcon(0, NUMBER_OF_LCD_COLS-1, GLYPHS_ICON_UNLOCK);	/* Unlock icon at end of row */
+	holdWithBar(start, 15, 33);					/* Wait for 15 seconds */
+	MESSAGES_displayRowColumn(0, 0, MESSAGE_DOOR_OPEN);	/* Display door open message over same sized one */
+	holdWithBar(start, 18, 33);					/* Wait for 3 seconds */
+	MESSAGES_displayRowColumn(0, 0, MESSAGE_DOOR_CLOSING);	/* Display door closing message over same sized one */
+	GLYPHS_drawIcon(0, NUMBER_OF_LCD_COLS-1, GLYPHS_ICON_LOCK);	/* Door is locking again */
+	holdWithBar(start, 33, 33);					/* Wait for 15 seconds */
+	TIMER1_stop();									/* Stop timer 1 */
 }
 
 /*******************************************************************************
- * [Function Name]	: unlockSystem
- * [Description]	: Start MCU unlocking actions
+ * [Function Name]	: getKey
+ * [Description]	: Wait for a debounced key press while serving watchdog
  * [Args]			: N/A
+ * [Returns]		: [unsigned character] key pressed on keypad
+ *******************************************************************************/
+uint8 getKey(void){
+	uint8 key;												/* Variable to hold key scanned */
+	while(KEYPAD_NO_KEY == (key = KEYPAD_readKey()))		/* Wait until scanner publishes a key press */
+		SUPERVISOR_kick();									/* Kick watchdog while waiting for user */
+	return key;												/* Return key pressed */
+}
+
+/*******************************************************************************
+ * [Function Name]	: getNumber
+ * [Description]	: Get a decimal number of fixed digits from user, typed digits
+ * 					  are shown at cursor and a long press of KEY_CLEAR_ENTRY
+ * 					  clears them
+ * [Args]
+ * 		[IN] unsigned char a_digits
+ * 					: Number of digits to type, up to 4
+ *
+ * [Returns]		: [unsigned short] number typed
+ *******************************************************************************/
+uint16 getNumber(uint8 a_digits){
+	KEYPAD_EventType event;									/* Variable to hold key event */
+	uint16 value = 0;										/* Number typed so far */
+	uint8 typed = 0;										/* Digits typed so far */
+	while (typed < a_digits){								/* Until all digits are typed */
+		getKeyEvent(&event);
+		if (KEYPAD_EVENT_PRESS == event.kind && event.key >= '0' && event.key <= '9'){	/* Digit typed */
+			value = value * 10 + (event.key - '0');
+			typed++;
+			LCD_displayCharacter(event.key);				/* Show digit typed */
+		}
+		else if (KEYPAD_EVENT_LONG_PRESS == event.kind && KEY_CLEAR_ENTRY == event.key){	/* Quick clear of typed digits */
+			value = 0;
+			while (typed != 0){								/* Erase every displayed digit */
+				typed--;
+				LCD_eraseCharacter();
+			}
+		}
+	}
+	return value;
+}
+
+/*******************************************************************************
+ * [Function Name]	: getKeyEvent
+ * [Description]	: Wait for any key event while serving watchdog
+ * [Args]
+ * 		[OUT] KEYPAD_EventType * a_event_Ptr
+ * 					: Variable to read event into
+ *
  * [Returns]		: N/A
  *******************************************************************************/
-void unlockSystem(void){
-	TIMER1_start();									/* Start timer 1 */
-	LCD_displayStringOnNewScreen("Opening door");	/* Display door opening message */
-	while(g_timePassed <= 15);						/* Wait for 15 seconds */
-	LCD_displayStringOnNewScreen("Door is open");	/* Display door open message */
-	while(g_timePassed <= 18);						/* Wait for 3 seconds */
-	LCD_displayStringOnNewScreen("Closing door");	/* Display door closing message */
-	while(g_timePassed <= 33);						/* Wait for 15 seconds */
-	TIMER1_stop();									/* Stop timer 1 */
+void getKeyEvent(KEYPAD_EventType *a_event_Ptr){
+	while(!KEYPAD_getEvent(a_event_Ptr))					/* Wait until scanner publishes an event */
+		SUPERVISOR_kick();									/* Kick watchdog while waiting for user */
+}
+
+/*******************************************************************************
+ * [Function Name]	: holdDelay
+ * [Description]	: Blind delay used to hold messages while serving watchdog
+ * [Args]
+ * 		[IN] unsigned short a_time
+ * 					: Delay time in milliseconds, multiple of 10
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void holdDelay(uint16 a_time){
+	PROFILER_MEASURE(PROFILER_SITE_BLIND_DELAY,
+		for (uint16 i = 0; i < a_time; i += 10){			/* Delay in 10ms steps */
+			_delay_ms(10);									/* Wait 10ms */
+			SUPERVISOR_kick();								/* Kick watchdog */
+		}
+	);
+}
+
+/*******************************************************************************
+ * [Function Name]	: holdWithBar
+ * [Description]	: Wait while serving watchdog until timer 1 counted a second,
+ * 					  showing time passed as a bar on last LCD row
+ * [Args]
+ * 		[IN] unsigned long a_start
+ * 					: Timer 1 time stamp taken when counting seconds started
+ * 		[IN] unsigned char a_second
+ * 					: Wait until this second of count passed
+ * 		[IN] unsigned char a_lastSecond
+ * 					: Last second of whole timed state, bar is full after it
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void holdWithBar(uint32 a_start, uint8 a_second, uint8 a_lastSecond){
+	uint32 total = (uint32)(a_lastSecond + 1) * TIMER1_TICKS_PER_SECOND;	/* Ticks of whole timed state */
+	uint32 passed;															/* Ticks passed so far */
+	PROFILER_MEASURE(PROFILER_SITE_TIMER_WAIT,
+		while(g_timePassed <= a_second){
+			passed = TIMER1_now() - a_start;
+			if (passed > total)
+				passed = total;
+			GLYPHS_drawBar(NUMBER_OF_LCD_ROWS-1, 0, NUMBER_OF_LCD_COLS, passed, total);
+			SUPERVISOR_kick();
+		}
+	);
+}
+
+/*******************************************************************************
+ * [Function Name]	: bootSystem
+ * [Description]	: Bring up MCU on every start without blocking delays. LCD powers
+ * 					  up and keypad is scanned in background while handshake is
+ * 					  repeated until control MCU answers, welcome message shows
+ * 					  only if that takes longer than LCD start up. Control MCU
+ * 					  owns the state, so a watchdog restart takes it from the
+ * 					  answer instead of resuming its own.
+ * [Args]			: N/A
+ * [Returns]		: State to start in, as answered by control MCU
+ *******************************************************************************/
+FSM_StateType bootSystem(void){
+	uint8 answer = 0;										/* Handshake answer, 0 until received */
+	uint32 nextHello = TIMER1_now();						/* Time to send next handshake request */
+	MESSAGES_displayOnNewScreen(MESSAGE_WELCOME);			/* Drawn once LCD is powered up */
+	while (0 == answer || !LCD_isIdle()){					/* Until link answered and LCD set up */
+		uint8 data;											/* Symbol received */
+		if (USART_receiveSymbol(&data)){					/* Control MCU answered */
+			if (LINK_SETUP == data || LINK_READY == data || LINK_LOCKED == data)
+				answer = data;
+		}
+		else if (0 == answer && (sint32)(TIMER1_now() - nextHello) >= 0){	/* Control MCU may not be listening yet */
+			USART_sendByte(LINK_HELLO);
+			nextHello += HELLO_PERIOD;
+		}
+		SUPERVISOR_kick();									/* Kick watchdog while starting up */
+	}
+	PROFILER_RECORD_SINCE_START(PROFILER_SITE_BOOT);		/* Time to ready */
+	if (LINK_SETUP == answer)								/* No password set */
+		return FSM_STATE_SETUP_NEW;
+	return (LINK_LOCKED == answer) ? FSM_STATE_LOCKED : FSM_STATE_READY;
+}
+
+/*******************************************************************************
+ * [Function Name]	: receiveResult
+ * [Description]	: Receive action result from control MCU, answers to repeated
+ * 					  handshake requests that arrive late are skipped. Watchdog
+ * 					  is served for RESULT_TIMEOUT, a control MCU silent for
+ * 					  longer lets it restart this MCU to handshake again.
+ * [Args]			: N/A
+ * [Returns]		: [unsigned character] action result symbol
+ *******************************************************************************/
+uint8 receiveResult(void){
+	uint8 result;											/* Variable to hold symbol received */
+	uint32 start = TIMER1_now();							/* Time stamp waiting started */
+	do{
+		while (!USART_receiveSymbol(&result))				/* Control MCU may be writing memory */
+			if ((sint32)(TIMER1_now() - start) < (sint32)RESULT_TIMEOUT)
+				SUPERVISOR_kick();							/* Kick watchdog until result is overdue */
+	}while(LINK_SETUP == result || LINK_READY == result);	/* Skip late handshake and status answers */
+	return result;
 }
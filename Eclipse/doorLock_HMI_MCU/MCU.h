@@ -20,20 +20,57 @@
  *******************************************************************************/
 
 #include "lcd.h"
+#include "messages.h"
+#include "glyphs.h"
 #include "keypad.h"
 #include "usart.h"
 #include "timers.h"
+#include "profiler.h"
+#include "supervisor.h"
+#include "fsm.h"
 
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
 
 #define PASSWORD_LENGTH 6		/* Length of password containers */
+#define PROFILER_REPORT_KEY '+'	/* Key requesting a profiler report while idle */
+#define KEY_3X4_ALTERNATE '#'	/* Key replacing '=' and '-' on 3x4 keypads */
+#define KEY_CLEAR_ENTRY '*'	/* Long press clears digits typed so far */
+#define KEY_SERVICE		'0'	/* Long press while idle opens service menu, on both keypad layouts */
+#define SERVICE_GROUP	0		/* Schedule group of password holder, set from service menu */
+#define SERVICE_ALL_DAYS 0x7F	/* Access window added from service menu applies Monday to Sunday */
+#define MESSAGE_DELAY	2000	/* Time in ms a message is held on screen */
+#define HELLO_PERIOD	TIMER1_MS_TO_TICKS(20)	/* Time between handshake requests while control MCU does not answer */
+#define STATUS_PERIOD	TIMER1_MS_TO_TICKS(500)	/* Time between status queries while locked out */
+#define RESULT_TIMEOUT	TIMER1_MS_TO_TICKS(2000)	/* Longest wait for an action result, covers memory writes */
+#define LOCKOUT_SECONDS	60		/* Lockout length after error limit reached */
 
 
 /* Action success, fail, and error codes */
 #define ACTION_SUCCESS 	'!'
 #define ACTION_FAIL		')'
 #define ACTION_ERROR	'E'
+#define ACTION_DENIED	'D'
+
+/* Start up handshake, sent on cold start and answered with password state */
+#define LINK_HELLO		'H'			/* HMI MCU started, asks for state */
+#define LINK_SETUP		'S'			/* No password saved, set one up */
+#define LINK_READY		'R'			/* Password saved, wait for actions */
+#define LINK_LOCKED		'L'			/* Lockout running, join it */
+
+/* Sent while locked out, status query is answered with ready once lockout ended */
+#define LINK_STATUS		'Q'			/* Status query to control MCU */
+#define LINK_COUNTDOWN	'C'			/* Lockout running, followed by seconds left */
+
+/* Service menu, password and then one clock or schedule command follow */
+#define LINK_SERVICE	'$'			/* Service menu chosen, sent again to leave it without a command */
+#define RTC_SET_TIME_COMMAND	'@'	/* Followed by weekday, hour, minute, second */
+#define RTC_CALIBRATE_COMMAND	'^'	/* Followed by ppm low byte, ppm high byte */
+#define SCHEDULE_COMMAND		'&'	/* Followed by group, days mask, start hour, start minute, end hour, end minute */
+
+/* Streamed password symbols, digits are sent as typed */
+#define PASSWORD_END	'\0'		/* Password confirmed, same as string terminator */
+#define PASSWORD_CLEAR	'\b'		/* Digits typed so far are dropped */
 
 #endif /* MCU_H_ */
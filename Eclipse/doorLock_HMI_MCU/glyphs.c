@@ -0,0 +1,98 @@
+/******************************************************************************
+ *
+ * 		Module: Glyphs
+ *
+ *	 File Name: glyphs.c
+ *
+ * Description: Source file for custom LCD icons and progress bar
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "glyphs.h"
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+/* Icon bitmaps, indexed by GLYPHS_Icon */
+static const uint8 g_icons[][LCD_GLYPH_ROWS] PROGMEM = {
+	{0x0E, 0x11, 0x11, 0x1F, 0x1B, 0x1B, 0x1F, 0x00},	/* Closed padlock */
+	{0x0E, 0x10, 0x10, 0x1F, 0x1B, 0x1B, 0x1F, 0x00}	/* Open padlock */
+};
+
+/* Partly filled bar cells, 1 to 4 pixel columns filled from left, full cell uses ROM block */
+static const uint8 g_barCells[GLYPHS_CELL_COLUMNS-1][LCD_GLYPH_ROWS] PROGMEM = {
+	{0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00},
+	{0x00, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00},
+	{0x00, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x00},
+	{0x00, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x00}
+};
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: GLYPHS_drawIcon
+ * [Description]	: Display an icon at provided location
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put icon on
+ * 		[IN] unsigned char a_col
+ * 					: Column to put icon on
+ * 		[IN] GLYPHS_Icon a_icon
+ * 					: Icon to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void GLYPHS_drawIcon(uint8 a_row, uint8 a_col, GLYPHS_Icon a_icon){
+	LCD_goToRowColumn(a_row, a_col);
+	LCD_displayCharacter(LCD_loadGlyph(g_icons[a_icon]));	/* Uploaded once, then only referenced */
+}
+
+/*******************************************************************************
+ * [Function Name]	: GLYPHS_drawBar
+ * [Description]	: Display a bar filled in proportion to a value with one pixel
+ * 					  column steps, only cells that changed are sent to LCD
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put bar on
+ * 		[IN] unsigned char a_col
+ * 					: Column bar starts at
+ * 		[IN] unsigned char a_width
+ * 					: Number of cells bar takes
+ * 		[IN] unsigned long a_value
+ * 					: Filled part, values above a_max show a full bar
+ * 		[IN] unsigned long a_max
+ * 					: Value of a full bar, a_max * a_width * 5 must fit in 32 bits
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void GLYPHS_drawBar(uint8 a_row, uint8 a_col, uint8 a_width, uint32 a_value, uint32 a_max){
+	uint16 columns = (uint16)a_width * GLYPHS_CELL_COLUMNS;	/* Pixel columns of full bar */
+	uint16 filled = (a_value >= a_max) ? columns : (uint16)(a_value * columns / a_max);	/* Pixel columns to fill */
+
+	LCD_goToRowColumn(a_row, a_col);
+	for (uint8 cell = 0; cell < a_width; cell++){
+		if (filled >= GLYPHS_CELL_COLUMNS){					/* Cell fully filled */
+			LCD_putCharacter(GLYPHS_FULL_BLOCK);
+			filled -= GLYPHS_CELL_COLUMNS;
+		}
+		else if (filled != 0){								/* Edge of bar */
+			LCD_putCharacter(LCD_loadGlyph(g_barCells[filled-1]));
+			filled = 0;
+		}
+		else
+			LCD_putCharacter(' ');							/* Empty part */
+	}
+	LCD_flush();											/* Shadow sends only cells that changed */
+}
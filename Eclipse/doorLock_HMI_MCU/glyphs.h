@@ -0,0 +1,87 @@
+ /******************************************************************************
+ *
+ * 		Module: Glyphs
+ *
+ *	 File Name: glyphs.h
+ *
+ * Description: Header file for custom LCD icons and progress bar
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef GLYPHS_H_
+#define GLYPHS_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+#include "lcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define GLYPHS_FULL_BLOCK		0xFF		/* Character ROM code of a solid cell	*/
+#define GLYPHS_CELL_COLUMNS		5			/* Pixel columns a bar cell is split in	*/
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: GLYPHS_Icon
+ * [Description]	: Enum for icons shown next to messages
+ *******************************************************************************/
+typedef enum
+{
+	GLYPHS_ICON_LOCK,			/* Closed padlock 	*/
+	GLYPHS_ICON_UNLOCK			/* Open padlock 	*/
+}GLYPHS_Icon;
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: GLYPHS_drawIcon
+ * [Description]	: Display an icon at provided location
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put icon on
+ * 		[IN] unsigned char a_col
+ * 					: Column to put icon on
+ * 		[IN] GLYPHS_Icon a_icon
+ * 					: Icon to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void GLYPHS_drawIcon(uint8 a_row, uint8 a_col, GLYPHS_Icon a_icon);
+
+/*******************************************************************************
+ * [Function Name]	: GLYPHS_drawBar
+ * [Description]	: Display a bar filled in proportion to a value with one pixel
+ * 					  column steps, only cells that changed are sent to LCD
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put bar on
+ * 		[IN] unsigned char a_col
+ * 					: Column bar starts at
+ * 		[IN] unsigned char a_width
+ * 					: Number of cells bar takes
+ * 		[IN] unsigned long a_value
+ * 					: Filled part, values above a_max show a full bar
+ * 		[IN] unsigned long a_max
+ * 					: Value of a full bar, a_max * a_width * 5 must fit in 32 bits
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void GLYPHS_drawBar(uint8 a_row, uint8 a_col, uint8 a_width, uint32 a_value, uint32 a_max);
+
+#endif /* GLYPHS_H_ */
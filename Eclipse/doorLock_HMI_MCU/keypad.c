@@ -17,124 +17,323 @@
  *******************************************************************************/
 
 #include "keypad.h"
+#include <avr/pgmspace.h>
+#include <avr/eeprom.h>
+
+/* Queue indices wrap with a mask */
+STATIC_ASSERT((KEYPAD_EVENT_QUEUE_SIZE & (KEYPAD_EVENT_QUEUE_SIZE - 1)) == 0, keypad_queue_size_not_power_of_2);
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: KEYPAD_KeyState
+ * [Description]	: Enum for debounce states of a single key
+ *******************************************************************************/
+typedef enum
+{
+	KEYPAD_KEY_RELEASED,		/* Key is up */
+	KEYPAD_KEY_PRESSING,		/* Key went down, waiting for it to settle */
+	KEYPAD_KEY_PRESSED,			/* Key is down */
+	KEYPAD_KEY_RELEASING		/* Key went up, waiting for it to settle */
+}KEYPAD_KeyState;
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+static KEYPAD_KeyState g_keyState[N_ROW*N_COL];		/* Debounce state of every key */
+static uint8 g_keySamples[N_ROW*N_COL];				/* Equal samples counted in current state */
+static uint8 g_column;								/* Column currently driven low */
+static uint16 g_scanMatrix;							/* Raw keys read so far in current matrix scan */
+static uint16 g_heldMatrix;							/* Debounced keys held */
+static uint16 g_longMatrix;							/* Held keys that passed long press time */
+static uint32 g_keyGesture[N_ROW*N_COL];			/* Time stamp of next long press or repeat of held keys */
+static uint32 g_scanTime;							/* Time stamp of last complete matrix scan */
+static const uint8 *g_keymap;						/* Keymap of selected layout, in flash */
+static KEYPAD_EventType g_events[KEYPAD_EVENT_QUEUE_SIZE];	/* Key events not taken yet */
+static volatile uint8 g_eventHead;						/* Index of next event to write, changed by scanner */
+static volatile uint8 g_eventTail;						/* Index of next event to take, changed by application */
+static volatile bool g_eventOverflow;					/* Events dropped on a full queue, not taken yet */
+
+/* ASCII legend of every matrix position per layout, kept in flash to not waste SRAM */
+static const uint8 g_keymaps[KEYPAD_LAYOUTS][N_ROW*N_COL] PROGMEM = {
+	{	/* KEYPAD_LAYOUT_4X4 */
+		'7', '8', '9', '/',
+		'4', '5', '6', '*',
+		'1', '2', '3', '-',
+		'\r', '0', '=', '+'
+	},
+	{	/* KEYPAD_LAYOUT_3X4, fourth column is not connected */
+		'1', '2', '3', KEYPAD_NO_KEY,
+		'4', '5', '6', KEYPAD_NO_KEY,
+		'7', '8', '9', KEYPAD_NO_KEY,
+		'*', '0', '#', KEYPAD_NO_KEY
+	}
+};
 
 /*******************************************************************************
  *                    Private Function Prototypes                              *
  *******************************************************************************/
 
-#if (N_COL == 3)
-/*
- * Button mapping function for 3x4 keypads
- */
-static uint8 KEYPAD_4x3_adjustSwitchNumber(uint8 a_keyNumber);
-#elif (N_COL == 4)
-/*
- * Button mapping function for 4x4 keypads
- */
-static uint8 KEYPAD_4x4_adjustSwitchNumber(uint8 a_keyNumber);
-#endif
+static void KEYPAD_scanColumn(void);							/* Scan deadline callback */
+static void KEYPAD_debounce(uint8 a_keyIndex, bool a_isDown);	/* Key debounce state machine */
+static bool KEYPAD_isGhosted(uint16 a_matrix);					/* Check matrix for phantom keys */
+static void KEYPAD_driveColumn(uint8 a_col);					/* Drive one column low */
+static void KEYPAD_classifyHold(uint8 a_keyIndex);				/* Long press and repeat classifier */
+static void KEYPAD_publish(uint8 a_keyIndex, KEYPAD_EventKind a_kind);	/* Queue a key event */
+
+/* Periodic timer 1 deadline scanning one column every period */
+static TIMER_DeadlineType g_scanDeadline = {0, KEYPAD_SCAN_PERIOD, KEYPAD_scanColumn, NULL};
 
 /*******************************************************************************
  *                       Function Definitions                                  *
  *******************************************************************************/
 
 /*******************************************************************************
- * [Function Name]	: Keypad_getPressed
- * [Description]	: Function responsible for getting the key pressed on the keypad
+ * [Function Name]	: KEYPAD_init
+ * [Description]	: Select keymap saved in internal EEPROM and start background keypad
+ * 					  scanning on a periodic timer 1 deadline, timer 1 must be
+ * 					  initialized first
  * [Args]			: N/A
- * [Returns]		: [unsigned character] key pressed on keypad
- *******************************************************************************/
-uint8 KEYPAD_getPressed(void){
-	while(1){
-		for (uint8 col = 0; col < N_COL; col++){		/* Loop to pass through all columns */
-			KEYPAD_PORT_DIR = 0x10<<col;				/* Setting 1 column as output at a time */
-			KEYPAD_PORT_OUT = ~(0x10<<col);				/* Setting current column output as 0 and activating pull-up resistor for all rows */
-			for (uint8 row = 0; row < N_ROW; row++){	/* Loop to pass through all rows for currently active column */
-				if (BIT_IS_CLEAR(KEYPAD_PORT_IN, row)){	/* Check if key pressed in any row */
-#if N_COL == 3
-					return KEYPAD_4x3_adjustSwitchNumber((row*N_COL)+col+1);	/* return value of key pressed */
-#elif N_COL == 4
-					return KEYPAD_4x4_adjustSwitchNumber((row*N_COL)+col+1);	/* return value of key pressed */
-#endif
-				}
-			}
-		}
-	}
+ * [Returns]		: N/A
+ *******************************************************************************/
+void KEYPAD_init(void){
+	uint8 layout = eeprom_read_byte(KEYPAD_LAYOUT_ADDRESS);		/* Layout saved for this board */
+	g_keymap = g_keymaps[(layout < KEYPAD_LAYOUTS) ? layout : KEYPAD_LAYOUT_4X4];	/* Erased memory selects 4x4 */
+	g_column = 0;											/* Start from first column */
+	KEYPAD_driveColumn(g_column);							/* Let it settle until first scan */
+	TIMER1_schedule(&g_scanDeadline, KEYPAD_SCAN_PERIOD);	/* Start scanning */
 }
 
-#if N_COL == 3
 /*******************************************************************************
- * [Function Name]	: Keypad_4x3_adjustSwitchNumber
- * [Description]	: Function responsible for mapping the key pressed on keypad
- * 					  to a correct output
+ * [Function Name]	: KEYPAD_getEvent
+ * [Description]	: Take oldest key event from the event queue without waiting
  * [Args]
- * 		[IN] unsigned char a_keyNumber
- * 					: index of key pressed on keypad
+ * 		[OUT] KEYPAD_EventType * a_event_Ptr
+ * 					: Variable to read event into
  *
- * [Returns]		: [unsigned character] key pressed on keypad
+ * [Returns]		: TRUE if an event was taken, FALSE if queue is empty
  *******************************************************************************/
-static uint8 KEYPAD_4x3_adjustSwitchNumber(uint8 a_keyNumber)
-{
-	switch(a_keyNumber)
-	{
-	case 10: return '*'; /* ASCII Code of * */
+bool KEYPAD_getEvent(KEYPAD_EventType *a_event_Ptr){
+	uint8 tail = g_eventTail;						/* Only application moves tail */
+	if (tail == g_eventHead)						/* Queue is empty */
+		return FALSE;
+	*a_event_Ptr = g_events[tail];					/* Take event, scanner does not write it until slot is freed */
+	g_eventTail = (tail + 1) & (KEYPAD_EVENT_QUEUE_SIZE - 1);	/* Free its slot */
+	return TRUE;
+}
 
-	case 11: return 0;
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_flush
+ * [Description]	: Drop all queued key events, used when typed-ahead keys are stale
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void KEYPAD_flush(void){
+	g_eventTail = g_eventHead;						/* Free all slots */
+}
+
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_takeOverflow
+ * [Description]	: Check if key events were dropped on a full queue since last
+ * 					  check, and clear the report
+ * [Args]			: N/A
+ * [Returns]		: TRUE if events were dropped, queued ones miss keys typed after them
+ *******************************************************************************/
+bool KEYPAD_takeOverflow(void){
+	uint8 sreg = SREG;								/* Save interrupt state */
+	cli();											/* Scanner may report a drop in between */
+	bool overflow = g_eventOverflow;
+	g_eventOverflow = FALSE;
+	SREG = sreg;									/* Restore interrupt state */
+	return overflow;
+}
+
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_readKey
+ * [Description]	: Take oldest queued key press without waiting, other events are dropped
+ * [Args]			: N/A
+ * [Returns]		: [unsigned character] ASCII key pressed on keypad or KEYPAD_NO_KEY
+ *******************************************************************************/
+uint8 KEYPAD_readKey(void){
+	KEYPAD_EventType event;							/* Event taken from queue */
+	while (KEYPAD_getEvent(&event))					/* Drain queue up to first press */
+		if (KEYPAD_EVENT_PRESS == event.kind)
+			return event.key;
+	return KEYPAD_NO_KEY;
+}
 
-	case 12: return '#'; /* ASCII Code of # */
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_scanColumn
+ * [Description]	: Sample rows of driven column into matrix and drive next column,
+ * 					  debounce all keys once the whole matrix is sampled
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void KEYPAD_scanColumn(void){
+	uint8 rows = KEYPAD_PORT_IN;						/* Rows read low for pressed keys */
+	for (uint8 row = 0; row < N_ROW; row++)				/* Add keys of column to matrix */
+		if (BIT_IS_CLEAR(rows, row))
+			g_scanMatrix |= KEYPAD_KEY_BIT(row, g_column);
 
-	default: return a_keyNumber;
+	if (++g_column == N_COL){							/* Whole matrix sampled */
+		g_column = 0;
+		g_scanTime = TIMER1_now();						/* All events of this scan share its time stamp */
+		if (!KEYPAD_isGhosted(g_scanMatrix))			/* Drop scan if held keys can not be told apart from phantom keys */
+			for (uint8 key = 0; key < N_ROW*N_COL; key++)	/* Debounce every key with this scan */
+				KEYPAD_debounce(key, (g_scanMatrix >> key) & 1);
+		g_scanMatrix = 0;								/* Start new matrix scan */
 	}
+	KEYPAD_driveColumn(g_column);						/* Settles until next scan */
 }
 
-#elif N_COL == 4
 /*******************************************************************************
- * [Function Name]	: Keypad_4x4_adjustSwitchNumber
- * [Description]	: Function responsible for mapping the key pressed on keypad
- * 					  to a correct output
+ * [Function Name]	: KEYPAD_isGhosted
+ * [Description]	: Check if a matrix scan may contain phantom keys
+ *
+ * 					  Without diodes, keys held on 3 corners of a rectangle
+ * 					  connect the 4th corner too. Any 2 rows sharing 2 or
+ * 					  more columns make the scan ambiguous.
  * [Args]
- * 		[IN] unsigned char a_keyNumber
- * 					: index of key pressed on keypad
+ * 		[IN] unsigned short a_matrix
+ * 					: Raw matrix scan
  *
- * [Returns]		: [unsigned character] key pressed on keypad
+ * [Returns]		: TRUE if scan is ambiguous
  *******************************************************************************/
-static uint8 KEYPAD_4x4_adjustSwitchNumber(uint8 a_keyNumber){
-
-	switch(a_keyNumber)
-	{
-	case 1: return 7;
-
-	case 2: return 8;
-
-	case 3: return 9;
-
-	case 4: return '/'; 	/* ASCII Code of / */
-
-	case 5: return 4;
-
-	case 6: return 5;
-
-	case 7: return 6;
-
-	case 8: return '*';		/* ASCII Code of '*' */
-
-	case 9: return 1;
-
-	case 10: return 2;
-
-	case 11: return 3;
-
-	case 12: return '-';	/* ASCII Code of '-' */
-
-	case 13: return 13;  	/* ASCII Code of Enter */
-
-	case 14: return 0;
+static bool KEYPAD_isGhosted(uint16 a_matrix){
+	uint8 rowKeys[N_ROW];								/* Columns held in every row */
+	for (uint8 row = 0; row < N_ROW; row++)
+		rowKeys[row] = (a_matrix >> (row*N_COL)) & ((1 << N_COL) - 1);
+	for (uint8 first = 0; first < N_ROW; first++){
+		for (uint8 second = first + 1; second < N_ROW; second++){
+			uint8 shared = rowKeys[first] & rowKeys[second];	/* Columns held in both rows */
+			if (shared & (shared - 1))					/* More than one column shared */
+				return TRUE;
+		}
+	}
+	return FALSE;
+}
 
-	case 15: return '='; 	/* ASCII Code of '=' */
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_debounce
+ * [Description]	: Run debounce state machine of a key with a new matrix sample
+ * [Args]
+ * 		[IN] unsigned char a_keyIndex
+ * 					: Index of key in matrix, row*N_COL+col
+ * 		[IN] bool a_isDown
+ * 					: TRUE if key was read pressed
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void KEYPAD_debounce(uint8 a_keyIndex, bool a_isDown){
+	switch(g_keyState[a_keyIndex]){
+	case KEYPAD_KEY_RELEASED:
+		if (a_isDown){										/* Key may be going down */
+			g_keyState[a_keyIndex] = KEYPAD_KEY_PRESSING;
+			g_keySamples[a_keyIndex] = 1;
+		}
+		break;
+	case KEYPAD_KEY_PRESSING:
+		if (!a_isDown)										/* Bounce, key is still up */
+			g_keyState[a_keyIndex] = KEYPAD_KEY_RELEASED;
+		else if (++g_keySamples[a_keyIndex] == KEYPAD_DEBOUNCE_SAMPLES){	/* Key settled down */
+			g_keyState[a_keyIndex] = KEYPAD_KEY_PRESSED;
+			g_heldMatrix |= (uint16)1 << a_keyIndex;		/* Add key to held keys */
+			g_keyGesture[a_keyIndex] = g_scanTime + KEYPAD_LONG_PRESS_TIME;	/* Long press is due after hold time */
+			KEYPAD_publish(a_keyIndex, KEYPAD_EVENT_PRESS);	/* Publish key press */
+			if (g_heldMatrix & ~((uint16)1 << a_keyIndex))	/* Other keys are held with it */
+				KEYPAD_publish(a_keyIndex, KEYPAD_EVENT_CHORD);	/* Publish chord */
+		}
+		break;
+	case KEYPAD_KEY_PRESSED:
+		if (!a_isDown){										/* Key may be going up */
+			g_keyState[a_keyIndex] = KEYPAD_KEY_RELEASING;
+			g_keySamples[a_keyIndex] = 1;
+		}
+		else if ((sint32)(g_scanTime - g_keyGesture[a_keyIndex]) >= 0)	/* Key held until next gesture */
+			KEYPAD_classifyHold(a_keyIndex);
+		break;
+	case KEYPAD_KEY_RELEASING:
+		if (a_isDown)										/* Bounce, key is still down */
+			g_keyState[a_keyIndex] = KEYPAD_KEY_PRESSED;
+		else if (++g_keySamples[a_keyIndex] == KEYPAD_DEBOUNCE_SAMPLES){	/* Key settled up */
+			g_keyState[a_keyIndex] = KEYPAD_KEY_RELEASED;
+			g_heldMatrix &= ~((uint16)1 << a_keyIndex);		/* Remove key from held keys */
+			if (g_longMatrix & ((uint16)1 << a_keyIndex))	/* Long press already reported */
+				g_longMatrix &= ~((uint16)1 << a_keyIndex);
+			else
+				KEYPAD_publish(a_keyIndex, KEYPAD_EVENT_SHORT_PRESS);	/* Publish short press */
+			KEYPAD_publish(a_keyIndex, KEYPAD_EVENT_RELEASE);	/* Publish key release */
+		}
+		break;
+	}
+}
 
-	case 16: return '+'; 	/* ASCII Code of '+' */
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_classifyHold
+ * [Description]	: Publish long press or auto-repeat of a held key and set its next gesture time
+ * [Args]
+ * 		[IN] unsigned char a_keyIndex
+ * 					: Index of key in matrix, row*N_COL+col
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void KEYPAD_classifyHold(uint8 a_keyIndex){
+	uint16 bit = (uint16)1 << a_keyIndex;					/* Bit of key in matrices */
+	if (g_longMatrix & bit){								/* Long press already reported */
+		KEYPAD_publish(a_keyIndex, KEYPAD_EVENT_REPEAT);	/* Publish auto-repeat */
+	}
+	else{
+		g_longMatrix |= bit;								/* Key is now a long press */
+		KEYPAD_publish(a_keyIndex, KEYPAD_EVENT_LONG_PRESS);	/* Publish long press */
+	}
+	if (KEYPAD_REPEAT_PERIOD != 0)							/* Next repeat is due one period later */
+		g_keyGesture[a_keyIndex] += KEYPAD_REPEAT_PERIOD;
+	else													/* No repeat, wait for most of time stamp range */
+		g_keyGesture[a_keyIndex] += 0x7FFFFFFFUL;
+}
 
-	default: return a_keyNumber;
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_publish
+ * [Description]	: Queue a time stamped key event of a kind in KEYPAD_EVENT_MASK,
+ * 					  dropped and reported if queue is full
+ * [Args]
+ * 		[IN] unsigned char a_keyIndex
+ * 					: Index of key in matrix, row*N_COL+col
+ * 		[IN] enum KEYPAD_EventKind a_kind
+ * 					: Press or release
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void KEYPAD_publish(uint8 a_keyIndex, KEYPAD_EventKind a_kind){
+	uint8 key = pgm_read_byte(&g_keymap[a_keyIndex]);			/* One table load maps key to its legend */
+	if (KEYPAD_NO_KEY == key || !(KEYPAD_EVENT_MASK & KEYPAD_EVENT_BIT(a_kind)))	/* Not connected in this layout or not wanted */
+		return;
+	uint8 head = g_eventHead;									/* Only scanner moves head */
+	uint8 next = (head + 1) & (KEYPAD_EVENT_QUEUE_SIZE - 1);	/* Slot after this event */
+	if (next == g_eventTail){									/* Queue full, keep older keys in order */
+		g_eventOverflow = TRUE;									/* Let application know keys were lost */
+		return;
 	}
+	g_events[head].time = g_scanTime;							/* Time change settled */
+	g_events[head].keys = g_heldMatrix;							/* Keys held after change */
+	g_events[head].key = key;
+	g_events[head].kind = a_kind;
+	g_eventHead = next;											/* Make event visible */
+}
+
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_driveColumn
+ * [Description]	: Drive one column low, others and rows are pulled up inputs
+ * [Args]
+ * 		[IN] unsigned char a_col
+ * 					: Column to drive
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void KEYPAD_driveColumn(uint8 a_col){
+	KEYPAD_PORT_DIR = 0x10<<a_col;					/* Setting 1 column as output at a time */
+	KEYPAD_PORT_OUT = ~(0x10<<a_col);				/* Setting current column output as 0 and activating pull-up resistor for all rows */
 }
-#endif
@@ -22,30 +22,146 @@
 #include "std_types.h"
 #include "common_macros.h"
 #include "micro_config.h"
+#include "timers.h"
 
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
 
-/* Keypad configurations for number of rows and columns */
+/* Scanned matrix size, 3x4 keypads leave last column unconnected */
 #define N_COL 4		/* Number of columns in keypad	*/
 #define N_ROW 4 	/* Number of rows in keypad		*/
 
+/* Internal EEPROM byte selecting keymap at boot, written with the EEPROM image
+ * when the board is programmed, erased value selects 4x4. Kept off address 0,
+ * which a write during brown-out corrupts as EEAR resets to it. */
+#define KEYPAD_LAYOUT_ADDRESS	((uint8 *)0x0020)
+
 /* Keypad Port Configurations */
 #define KEYPAD_PORT_DIR DDRA	/* PORTA direction configuration	*/
 #define KEYPAD_PORT_IN  PINA 	/* PORTA input pins configuration 	*/
 #define KEYPAD_PORT_OUT PORTA 	/* PORTA output pins configuration 	*/
 
+#define KEYPAD_NO_KEY	0xFF	/* Value returned when no key press is pending */
+
+/* Background scanner timing, one column is scanned every period */
+#define KEYPAD_SCAN_PERIOD			TIMER1_MS_TO_TICKS(1)	/* Column scan period, full matrix every 4ms	*/
+#define KEYPAD_DEBOUNCE_SAMPLES		3						/* Equal samples needed to accept a change		*/
+#define KEYPAD_EVENT_QUEUE_SIZE		16						/* Key events buffered for type-ahead, power of 2	*/
+
+/* Event kinds queued for the application, other kinds are still classified but
+ * not queued so type-ahead is not spent on them. Default costs one slot per key
+ * typed plus one per long press or chord, override with -D */
+#define KEYPAD_EVENT_BIT(KIND)		((uint8)1 << (KIND))
+#ifndef KEYPAD_EVENT_MASK
+#define KEYPAD_EVENT_MASK			(KEYPAD_EVENT_BIT(KEYPAD_EVENT_PRESS) | KEYPAD_EVENT_BIT(KEYPAD_EVENT_LONG_PRESS) | \
+									 KEYPAD_EVENT_BIT(KEYPAD_EVENT_CHORD))
+#endif
+
+/* Press duration gestures, measured with timer 1 time stamps, override with -D */
+#ifndef KEYPAD_LONG_PRESS_TIME
+#define KEYPAD_LONG_PRESS_TIME		TIMER1_MS_TO_TICKS(800)	/* Hold time classifying a press as long		*/
+#endif
+#ifndef KEYPAD_REPEAT_PERIOD
+#define KEYPAD_REPEAT_PERIOD		TIMER1_MS_TO_TICKS(150)	/* Auto-repeat period after long press, 0 = off	*/
+#endif
+
+/* Bit of a key in matrix bitmaps, chords are compared as OR of key bits */
+#define KEYPAD_KEY_BIT(ROW,COL)		((uint16)1 << ((ROW)*N_COL + (COL)))
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: KEYPAD_Layout
+ * [Description]	: Enum for keypad layouts with a keymap in flash
+ *******************************************************************************/
+typedef enum
+{
+	KEYPAD_LAYOUT_4X4,			/* 4x4 calculator keypad */
+	KEYPAD_LAYOUT_3X4,			/* 3x4 phone keypad */
+	KEYPAD_LAYOUTS				/* Number of layouts */
+}KEYPAD_Layout;
+
+/*******************************************************************************
+ * [Enum Name]		: KEYPAD_EventKind
+ * [Description]	: Enum for kinds of key events published by the scanner
+ *******************************************************************************/
+typedef enum
+{
+	KEYPAD_EVENT_PRESS,			/* Key settled down */
+	KEYPAD_EVENT_RELEASE,		/* Key settled up */
+	KEYPAD_EVENT_CHORD,			/* Key settled down while other keys are held */
+	KEYPAD_EVENT_SHORT_PRESS,	/* Key released before long press time */
+	KEYPAD_EVENT_LONG_PRESS,	/* Key held for long press time */
+	KEYPAD_EVENT_REPEAT			/* Key still held, every repeat period after long press */
+}KEYPAD_EventKind;
+
+/*******************************************************************************
+ *						Structures & Unions	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Structure Name]	: KEYPAD_EventType
+ * [Description]	: Struct holding a key event taken from the event queue
+ *******************************************************************************/
+typedef struct
+{
+	uint32 time;				/* Timer 1 time stamp at which change settled */
+	uint16 keys;				/* Matrix of keys held after change, see KEYPAD_KEY_BIT */
+	uint8 key;					/* ASCII key legend from keymap of layout */
+	KEYPAD_EventKind kind;		/* Press or release */
+}KEYPAD_EventType;
+
 /*******************************************************************************
  *                      Function Declarations                                  *
  *******************************************************************************/
 
 /*******************************************************************************
- * [Function Name]	: Keypad_getPressed
- * [Description]	: Function responsible for getting the key pressed on the keypad
+ * [Function Name]	: KEYPAD_init
+ * [Description]	: Select keymap saved in internal EEPROM and start background keypad
+ * 					  scanning on a periodic timer 1 deadline, timer 1 must be
+ * 					  initialized first
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void KEYPAD_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_getEvent
+ * [Description]	: Take oldest key event from the event queue without waiting
+ * [Args]
+ * 		[OUT] KEYPAD_EventType * a_event_Ptr
+ * 					: Variable to read event into
+ *
+ * [Returns]		: TRUE if an event was taken, FALSE if queue is empty
+ *******************************************************************************/
+bool KEYPAD_getEvent(KEYPAD_EventType *a_event_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_flush
+ * [Description]	: Drop all queued key events, used when typed-ahead keys are stale
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void KEYPAD_flush(void);
+
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_takeOverflow
+ * [Description]	: Check if key events were dropped on a full queue since last
+ * 					  check, and clear the report
+ * [Args]			: N/A
+ * [Returns]		: TRUE if events were dropped, queued ones miss keys typed after them
+ *******************************************************************************/
+bool KEYPAD_takeOverflow(void);
+
+/*******************************************************************************
+ * [Function Name]	: KEYPAD_readKey
+ * [Description]	: Take oldest queued key press without waiting, other events are dropped
  * [Args]			: N/A
- * [Returns]		: [unsigned character] key pressed on keypad
+ * [Returns]		: [unsigned character] ASCII key pressed on keypad or KEYPAD_NO_KEY
  *******************************************************************************/
-uint8 KEYPAD_getPressed(void);
+uint8 KEYPAD_readKey(void);
 
 #endif /* KEYPAD_H_ */
@@ -17,6 +17,90 @@
  *******************************************************************************/
 
 #include "lcd.h"
+#include "profiler.h"
+#include <string.h>
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Data pin carrying busy flag (DB7) */
+#if DATA_BITS_MODE == 4 && !defined(UPPER_PORT_PINS)
+#define LCD_BUSY_BIT	3
+#else
+#define LCD_BUSY_BIT	7
+#endif
+
+/* DDRAM address of first cell of each row, rows 2 and 3 continue rows 0 and 1 */
+#define LCD_ROW_ADDRESS(ROW)	((((ROW) & 1) ? 0x40 : 0x00) + (((ROW) & 2) ? NUMBER_OF_LCD_COLS : 0))
+
+#define LCD_NO_ADDRESS			0xFF		/* LCD address counter is not known */
+#define LCD_CELLS				(NUMBER_OF_LCD_ROWS * NUMBER_OF_LCD_COLS)	/* Cells on screen */
+
+/* Read a string character from flash or SRAM */
+#define LCD_READ_CHARACTER(PTR, FLASH)	((FLASH) ? pgm_read_byte(PTR) : *(PTR))
+
+/* Queue indices wrap with a mask */
+STATIC_ASSERT((LCD_QUEUE_SIZE & (LCD_QUEUE_SIZE - 1)) == 0, lcd_queue_size_not_power_of_2);
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+static void LCD_service(void);					/* Service deadline callback, one LCD operation per call */
+static uint32 LCD_serviceOperation(void);		/* Do next LCD operation, returns delay before next one */
+static bool LCD_serviceGlyphs(void);			/* Upload next row of a glyph, FALSE if none pending */
+static bool LCD_serviceMarquee(void);			/* Load or scroll marquee, FALSE if nothing to do */
+static bool LCD_serviceFrame(void);				/* Write next changed shadow cell, FALSE if none */
+static void LCD_shiftMarquee(void);				/* Marquee deadline callback, requests a scroll step */
+static void LCD_kick(void);						/* Start service if idle */
+static void LCD_layoutString(const uint8 *a_string_Ptr, bool a_flash);	/* Write a wrapped string into shadow */
+static void LCD_wrapWord(uint8 a_wordCol);		/* Move word that does not fit to next row */
+static void LCD_newLine(void);					/* Move cursor to start of next row */
+static void LCD_write(uint8 a_data, uint8 a_rs);	/* Write a byte to command or data register */
+#if LCD_BUSY_FLAG
+static bool LCD_isBusy(void);					/* Read busy flag once */
+#endif
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+static uint8 g_frame[NUMBER_OF_LCD_ROWS][NUMBER_OF_LCD_COLS];	/* Shadow of what screen should show, written by application */
+static uint8 g_panel[NUMBER_OF_LCD_ROWS][NUMBER_OF_LCD_COLS];	/* What LCD is showing now, written by service */
+static uint8 g_cursorRow;					/* Shadow cursor row */
+static uint8 g_cursorCol;					/* Shadow cursor column, NUMBER_OF_LCD_COLS when past row end */
+static uint8 g_address;						/* LCD address counter, saves a set position per written cell */
+static uint8 g_scan;						/* Next cell service compares in current pass */
+static volatile bool g_dirty;				/* Shadow changed since service started its pass */
+static volatile bool g_running;				/* Service deadline is pending */
+#if LCD_BUSY_FLAG
+static uint8 g_busyPolls;					/* Busy flag reads since last operation */
+#endif
+
+static const uint8 *g_glyphs[LCD_GLYPH_SLOTS];	/* Flash address of glyph resident in each CGRAM slot */
+static volatile uint8 g_glyphPending;		/* Slots whose glyph is not uploaded yet, one bit per slot */
+static uint8 g_glyphUpload;					/* Slot being uploaded, LCD_GLYPH_SLOTS when none */
+static uint8 g_glyphRow;					/* Next row of glyph being uploaded */
+static uint8 g_nextGlyph;					/* Slot replaced by next new glyph */
+
+static uint8 g_commands[LCD_QUEUE_SIZE];	/* Commands not sent yet */
+static volatile uint8 g_commandHead;		/* Index of next command to write, changed by application */
+static volatile uint8 g_commandTail;		/* Index of next command to send, changed by service */
+
+static volatile uint8 g_marquee = LCD_MARQUEE_OFF;	/* Marquee state, shadow is not sent while not off */
+static LCD_SourceType *g_marqueeSource;		/* Marquee text, read one character per load step */
+static uint8 g_marqueeRow;					/* Row marquee is on */
+static uint8 g_marqueeCol;					/* Next DDRAM column loaded */
+static bool g_marqueeEnded;					/* Text end reached, rest of line is padded */
+static volatile uint8 g_marqueeShifts;		/* Scroll steps requested and not sent yet */
+
+/* One shot timer 1 deadline, rescheduled by the service while there is work */
+static TIMER_DeadlineType g_serviceDeadline = {0, 0, LCD_service, NULL};
+
+/* Periodic timer 1 deadline stepping marquee */
+static TIMER_DeadlineType g_marqueeDeadline = {0, LCD_MARQUEE_PERIOD, LCD_shiftMarquee, NULL};
 
 /*******************************************************************************
  *                      Function Definitions                                   *
@@ -24,7 +108,8 @@
 
 /*******************************************************************************
  * [Function Name]	: LCD_sendCommand
- * [Description]	: Send command to LCD
+ * [Description]	: Queue a command to LCD, bypassing the screen shadow, waits only
+ * 					  if queue is full
  * [Args]
  * 		[IN] unsigned char a_command
  * 					: Command to send to LCD
@@ -32,46 +117,18 @@
  * [Returns]		: N/A
  *******************************************************************************/
 void LCD_sendCommand(uint8 a_command){
-
-	CLEAR_BIT(LCD_CTRL_PORT, RS); 	/* Select command register */
-	CLEAR_BIT(LCD_CTRL_PORT, RW);	/* Select Write mode */
-	_delay_ms(1);					/* 50ns Address set-up time */
-	SET_BIT(LCD_CTRL_PORT, E);		/* Enable LCD */
-	_delay_ms(1);					/* 190ns delay before data set-up (Tpw - Tdws) */
-
-#if DATA_BITS_MODE == 8				/* For 8 bits mode on LCD */
-	LCD_DATA_PORT = a_command;		/* Put required command on Data port */
-#elif DATA_BITS_MODE == 4			/* For 4 bits mode on LCD */
-	/* Send the 4 MSBs from the command first */
-#ifdef UPPER_PORT_PINS				/* if data pins are from Pin 4-7 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | (a_command & 0xF0);			/* Set-up command bits 4-7 to send */
-#else								/* if data pins are from Pin 0-3 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0xF0) | ((a_command & 0xF0) >> 4);		/* Set-up command bits 4-7 to send */
-#endif
-
-	_delay_ms(1);					/* 100ns delay for data set-up */
-	CLEAR_BIT(LCD_CTRL_PORT, E);	/* Disable LCD */
-	_delay_ms(1);					/* 13ns delay for data hold time */
-	SET_BIT(LCD_CTRL_PORT, E);		/* Enable LCD */
-	_delay_ms(1);					/* 190ns delay before data set-up (Tpw - Tdws) */
-
-	/* Send the 4 LSBs from the command last */
-#ifdef UPPER_PORT_PINS				/* if data pins are from Pin 4-7 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | ((a_command & 0x0F) << 4);		/* Set-up command bits 0-3 to send */
-#else								/* if data pins are from Pin 0-3 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0xF0) | (a_command & 0x0F);			/* Set-up command bits 0-3 to send */
-#endif
-
-#endif
-
-	_delay_ms(1);					/* 100ns delay for data set-up */
-	CLEAR_BIT(LCD_CTRL_PORT, E);	/* Disable LCD */
-	_delay_ms(1);					/* 13ns delay for data hold time */
+	uint8 head = g_commandHead;								/* Only application moves head */
+	uint8 next = (head + 1) & (LCD_QUEUE_SIZE - 1);			/* Slot after this command */
+	while (next == g_commandTail);							/* Queue full, wait for service to free a slot */
+	g_commands[head] = a_command;
+	g_commandHead = next;									/* Make command visible */
+	LCD_kick();												/* Make sure service is running */
 }
 
 /*******************************************************************************
  * [Function Name]	: LCD_init
- * [Description]	: Initialize LCD
+ * [Description]	: Initialize LCD, set-up commands are sent in background once LCD
+ * 					  powered up, timer 1 must be initialized first
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
@@ -79,6 +136,20 @@ void LCD_init(void){
 
 	LCD_CTRL_PORT_DIR = (HIGH << RS) | (HIGH << RW) | (HIGH << E);	/* Set Register select, Read/Write, and enable pins as o/p pins */
 
+	memset(g_panel, ' ', sizeof(g_panel));					/* Cleared LCD shows spaces */
+	memset(g_frame, ' ', sizeof(g_frame));					/* Shadow starts matching LCD */
+	g_cursorRow = 0;
+	g_cursorCol = 0;
+	g_address = LCD_NO_ADDRESS;
+	g_scan = LCD_CELLS;										/* No pass in progress */
+	g_dirty = FALSE;
+	g_commandHead = 0;
+	g_commandTail = 0;
+	memset(g_glyphs, 0, sizeof(g_glyphs));					/* No glyph resident after power up */
+	g_glyphPending = 0;
+	g_glyphUpload = LCD_GLYPH_SLOTS;
+	g_nextGlyph = 0;
+
 #if DATA_BITS_MODE == 8										/* For 8 bits mode on LCD */
 	LCD_DATA_PORT_DIR = 0xFF;								/* Set Data pins as o/p pins */
 	LCD_sendCommand(LCD_COMMAND_EIGHT_BIT_TWO_LINE_LCD);	/* Set-up LCD as 8 bit data 2 line LCD */
@@ -93,6 +164,9 @@ void LCD_init(void){
 
 	LCD_sendCommand(LCD_COMMAND_DISPLAY_ON_CURSOR_OFF);		/* Activate display and deactivate cursor */
 	LCD_sendCommand(LCD_COMMAND_CLEAR_DISPLAY);				/* Clear LCD to start working */
+
+	/* LCD ignores commands until it finished power up, hold first one back */
+	TIMER1_schedule(&g_serviceDeadline, TIMER1_MS_TO_TICKS(LCD_POWER_UP_DELAY));
 }
 
 /*******************************************************************************
@@ -105,41 +179,139 @@ void LCD_init(void){
  * [Returns]		: N/A
  *******************************************************************************/
 void LCD_displayCharacter(uint8 a_data){
+	LCD_putCharacter(a_data);		/* Write character into shadow */
+	LCD_flush();					/* Send it to LCD */
+}
 
-	SET_BIT(LCD_CTRL_PORT, RS); 	/* Select data register */
-	CLEAR_BIT(LCD_CTRL_PORT, RW);	/* Select Write mode */
-	_delay_ms(1);					/* 50ns Address set-up time */
-	SET_BIT(LCD_CTRL_PORT, E);		/* Enable LCD */
-	_delay_ms(1);					/* 190ns delay before data set-up (Tpw - Tdws) */
-
-#if DATA_BITS_MODE == 8				/* For 8 bits mode on LCD */
-	LCD_DATA_PORT = a_data;			/* Put required command on Data port */
-#elif DATA_BITS_MODE == 4			/* For 4 bits mode on LCD */
-	/* Send the 4 MSBs from the command first */
-#ifdef UPPER_PORT_PINS				/* if data pins are from Pin 4-7 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | (a_data & 0xF0);			/* Set-up command bits 4-7 to send */
-#else								/* if data pins are from Pin 0-3 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0xF0) | ((a_data & 0xF0) >> 4);		/* Set-up command bits 4-7 to send */
-#endif
+/*******************************************************************************
+ * [Function Name]	: LCD_putCharacter
+ * [Description]	: Write a character into the shadow at cursor and advance cursor,
+ * 					  characters past end of row are not visible and are dropped
+ * [Args]
+ * 		[IN] unsigned char a_data
+ * 					: Character to write
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_putCharacter(uint8 a_data){
+	if (g_cursorCol >= NUMBER_OF_LCD_COLS)				/* Past visible part of row */
+		return;
+	if (g_frame[g_cursorRow][g_cursorCol] != a_data){	/* Only a new character needs sending */
+		g_frame[g_cursorRow][g_cursorCol] = a_data;
+		g_dirty = TRUE;
+	}
+	g_cursorCol++;										/* Advance like LCD address counter does */
+}
 
-	_delay_ms(1);					/* 100ns delay for data set-up */
-	CLEAR_BIT(LCD_CTRL_PORT, E);	/* Disable LCD */
-	_delay_ms(1);					/* 13ns delay for data hold time */
-	SET_BIT(LCD_CTRL_PORT, E);		/* Enable LCD */
-	_delay_ms(1);					/* 190ns delay before data set-up (Tpw - Tdws) */
-
-	/* Send the 4 LSBs from the command last */
-#ifdef UPPER_PORT_PINS				/* if data pins are from Pin 4-7 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | ((a_data & 0x0F) << 4);		/* Set-up command bits 0-3 to send */
-#else								/* if data pins are from Pin 0-3 */
-	LCD_DATA_PORT = (LCD_DATA_PORT & 0xF0) | (a_data & 0x0F);			/* Set-up command bits 0-3 to send */
-#endif
+/*******************************************************************************
+ * [Function Name]	: LCD_loadGlyph
+ * [Description]	: Make a custom glyph resident in CGRAM, uploading it in background
+ * 					  only if it is not resident already. When all slots are used the
+ * 					  glyph loaded longest ago is replaced, cells showing it change too
+ * [Args]
+ * 		[IN] const unsigned char *a_glyph_Ptr
+ * 					: Flash address of LCD_GLYPH_ROWS rows, 5 low bits per row
+ *
+ * [Returns]		: Character code showing glyph
+ *******************************************************************************/
+uint8 LCD_loadGlyph(const uint8 *a_glyph_Ptr){
+	uint8 slot;									/* CGRAM slot of glyph */
+	for (slot = 0; slot < LCD_GLYPH_SLOTS; slot++)
+		if (g_glyphs[slot] == a_glyph_Ptr)		/* Already resident */
+			return slot;
 
-#endif
+	slot = g_nextGlyph;							/* Replace glyph loaded longest ago */
+	g_nextGlyph = (slot + 1) & (LCD_GLYPH_SLOTS - 1);
+	uint8 sreg = SREG;							/* Save interrupt state */
+	cli();										/* Service reads slot address */
+	g_glyphs[slot] = a_glyph_Ptr;
+	SET_BIT(g_glyphPending, slot);				/* Upload glyph */
+	SREG = sreg;								/* Restore interrupt state */
+	LCD_kick();
+	return slot;
+}
 
-	_delay_ms(1);					/* 100ns delay for data set-up */
-	CLEAR_BIT(LCD_CTRL_PORT, E);	/* Disable LCD */
-	_delay_ms(1);					/* 13ns delay for data hold time */
+/*******************************************************************************
+ * [Function Name]	: LCD_startMarquee
+ * [Description]	: Scroll decoded text on cursor row. Text is loaded once into the
+ * 					  whole DDRAM line, then every step is a single display shift
+ * 					  command. HD44780 shifts all rows together and shadow is not
+ * 					  sent while marquee runs
+ * [Args]
+ * 		[IN] LCD_SourceType * a_source_Ptr
+ * 					: Text source, read in background so it must outlive marquee,
+ * 					  up to LCD_DDRAM_COLS characters
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_startMarquee(LCD_SourceType *a_source_Ptr){
+	LCD_stopMarquee();							/* Start from unshifted display */
+	uint8 sreg = SREG;							/* Save interrupt state */
+	cli();										/* Service reads marquee state */
+	g_marqueeSource = a_source_Ptr;
+	g_marqueeRow = g_cursorRow;
+	g_marqueeCol = 0;
+	g_marqueeEnded = FALSE;
+	g_marqueeShifts = 0;
+	g_marquee = LCD_MARQUEE_LOADING;
+	SREG = sreg;								/* Restore interrupt state */
+	LCD_kick();
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_stopMarquee
+ * [Description]	: Stop scrolling and return display to shadow, nothing happens if
+ * 					  no marquee runs
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_stopMarquee(void){
+	if (g_marquee == LCD_MARQUEE_OFF)
+		return;
+	uint8 sreg = SREG;							/* Save interrupt state */
+	cli();										/* Service can not restart scrolling in between */
+	TIMER1_cancel(&g_marqueeDeadline);			/* No more scroll steps */
+	g_marquee = LCD_MARQUEE_OFF;
+	SREG = sreg;								/* Restore interrupt state */
+	LCD_sendCommand(LCD_COMMAND_RETURN_HOME);	/* Undo shift, sent before shadow resumes */
+	g_dirty = TRUE;								/* Resend cells marquee overwrote */
+	LCD_kick();
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_eraseCharacter
+ * [Description]	: Move cursor back one cell and blank it
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_eraseCharacter(void){
+	if (g_cursorCol == 0)					/* Nothing before cursor on this row */
+		return;
+	g_cursorCol--;							/* Step back */
+	LCD_putCharacter(' ');					/* Blank cell */
+	g_cursorCol--;							/* Stay on blanked cell */
+	LCD_flush();							/* Send it to LCD */
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_flush
+ * [Description]	: Start sending cells changed in the shadow to LCD in background
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_flush(void){
+	if (g_dirty)			/* Something changed since service started its pass */
+		LCD_kick();
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_isIdle
+ * [Description]	: Check if LCD shows the shadow and all queued commands were sent
+ * [Args]			: N/A
+ * [Returns]		: TRUE if nothing is left to send
+ *******************************************************************************/
+bool LCD_isIdle(void){
+	return !g_running;
 }
 
 /*******************************************************************************
@@ -152,21 +324,49 @@ void LCD_displayCharacter(uint8 a_data){
  * [Returns]		: N/A
  *******************************************************************************/
 void LCD_displayString(const uint8 *a_string_Ptr){
-	uint8 firstSpace = NUMBER_OF_LCD_COLS+1;				/* Variable to save position of first space character */
-	if(strlen(a_string_Ptr) > NUMBER_OF_LCD_COLS){			/* Check if screen will display more than 1 row of data */
-		for (int i = NUMBER_OF_LCD_COLS-1; i >= 0; i--){	/* Pass through the string to find last space before new line */
-			if(isspace(a_string_Ptr[i])){					/* Check if the character is a space */
-				firstSpace = i+1;							/* Save location of character after space */
-				break;										/* Leave loop to not get a wrong character location */
-			}
+	LCD_layoutString(a_string_Ptr, FALSE);					/* Write string from SRAM into shadow */
+	LCD_flush();											/* Send changed cells only */
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_displayStringFlash
+ * [Description]	: Display a string stored in program memory on the screen
+ * [Args]
+ * 		[IN] const unsigned char *a_string_Ptr
+ * 					: Flash address of string to display on the screen
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displayStringFlash(const uint8 *a_string_Ptr){
+	LCD_layoutString(a_string_Ptr, TRUE);					/* Write string from flash into shadow */
+	LCD_flush();											/* Send changed cells only */
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_displaySourceLayout
+ * [Description]	: Display decoded text using precomputed row breaks, characters are
+ * 					  written as they are decoded and no wrapping work is done
+ * [Args]
+ * 		[IN] LCD_SourceType * a_source_Ptr
+ * 					: Text source
+ * 		[IN] const unsigned char *a_breaks_Ptr
+ * 					: Flash address of NUMBER_OF_LCD_ROWS-1 character offsets where
+ * 					  each next row starts, LCD_NO_BREAK when text ends before
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displaySourceLayout(LCD_SourceType *a_source_Ptr, const uint8 *a_breaks_Ptr){
+	uint8 breaksLeft = NUMBER_OF_LCD_ROWS - 1;				/* Row breaks not reached yet */
+	uint8 nextBreak = breaksLeft ? pgm_read_byte(a_breaks_Ptr) : LCD_NO_BREAK;	/* Offset of next row start */
+	uint8 character;										/* Character being written */
+	for (uint8 charNum = 0; (character = a_source_Ptr->next(a_source_Ptr)) != '\0'; charNum++){
+		if (charNum == nextBreak){							/* Row starts at this character */
+			LCD_newLine();
+			nextBreak = --breaksLeft ? pgm_read_byte(++a_breaks_Ptr) : LCD_NO_BREAK;
 		}
+		LCD_putCharacter(character);
 	}
-	uint8 charNum = 0;										/* Iterator to pass through String literals */
-	while (a_string_Ptr[charNum] != '\0'){						/* Pass by string character by character until null character */
-		LCD_displayCharacter(a_string_Ptr[charNum++]);			/* call LCD_displayCharacter function for every character in string */
-		if (charNum == firstSpace)							/* Condition to display characters on a new line */
-			LCD_goToRowColumn((charNum+NUMBER_OF_LCD_COLS-1)/NUMBER_OF_LCD_COLS, 0);	/* Put cursor on needed location to continue display */
-	}
+	LCD_flush();											/* Send changed cells only */
 }
 
 /*******************************************************************************
@@ -181,26 +381,8 @@ void LCD_displayString(const uint8 *a_string_Ptr){
  * [Returns]		: N/A
  *******************************************************************************/
 void LCD_goToRowColumn(uint8 a_row, uint8 a_col){
-	uint8 positionAddress;					/* Variable to store address of position to start display */
-	switch(a_row){							/* Start calculating address using row position */
-	case 0:
-		positionAddress = a_col;			/* Add to row position column position to get final address */
-		break;
-	case 1:
-		positionAddress = a_col + 0x40;		/* Add to row position column position to get final address */
-		break;
-#if NUMBER_OF_LCD_ROWS == 4
-	case 2:
-		positionAddress = a_col + 0x10;		/* Add to row position column position to get final address */
-		break;
-	case 3:
-		positionAddress = a_col + 0x50;		/* Add to row position column position to get final address */
-		break;
-#endif
-	default:
-		positionAddress = a_col;			/* Display on first row if provided row is invalid */
-	}
-	LCD_sendCommand(LCD_COMMAND_SET_CURSOR_POSITION | positionAddress);		/* Send the required position to LCD */
+	g_cursorRow = (a_row < NUMBER_OF_LCD_ROWS) ? a_row : 0;		/* Display on first row if provided row is invalid */
+	g_cursorCol = (a_col < NUMBER_OF_LCD_COLS) ? a_col : NUMBER_OF_LCD_COLS;	/* Columns off screen are not visible */
 }
 
 /*******************************************************************************
@@ -221,14 +403,43 @@ void LCD_displayStringRowColumn(uint8 a_row, uint8 a_col, const uint8 *a_string_
 	LCD_displayString(a_string_Ptr);		/* Call LCD_displayString to start displaying string */
 }
 
+/*******************************************************************************
+ * [Function Name]	: LCD_displayStringRowColumnFlash
+ * [Description]	: Display String stored in program memory at provided location
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put cursor on on LCD
+ * 		[IN] unsigned char a_col
+ * 					: Column to put cursor on on LCD
+ * 		[IN] const unsigned char *a_string_Ptr
+ * 					: Flash address of string to display on the screen
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displayStringRowColumnFlash(uint8 a_row, uint8 a_col, const uint8 *a_string_Ptr){
+	LCD_goToRowColumn(a_row, a_col);		/* Set string display start position */
+	LCD_displayStringFlash(a_string_Ptr);	/* Display string from flash */
+}
+
 /*******************************************************************************
  * [Function Name]	: LCD_clearScreen
- * [Description]	: Clear screen
+ * [Description]	: Clear screen shadow and home cursor, LCD is updated on next flush
+ * 					  so text drawn right after does not flicker
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
 void LCD_clearScreen(void){
-	LCD_sendCommand(LCD_COMMAND_CLEAR_DISPLAY);		/* Send command to clear LCD */
+	LCD_stopMarquee();							/* New screen ends scrolling */
+	for (uint8 row = 0; row < NUMBER_OF_LCD_ROWS; row++){
+		for (uint8 col = 0; col < NUMBER_OF_LCD_COLS; col++){
+			if (g_frame[row][col] != ' '){		/* Only non blank cells need clearing */
+				g_frame[row][col] = ' ';
+				g_dirty = TRUE;
+			}
+		}
+	}
+	g_cursorRow = 0;							/* Home cursor */
+	g_cursorCol = 0;
 }
 
 /*******************************************************************************
@@ -245,6 +456,20 @@ void LCD_displayStringOnNewScreen(const uint8 *a_string_Ptr){
 	LCD_displayString(a_string_Ptr);	/* Display string on LCD */
 }
 
+/*******************************************************************************
+ * [Function Name]	: LCD_displayStringOnNewScreenFlash
+ * [Description]	: Display a string stored in program memory after clearing screen
+ * [Args]
+ * 		[IN] const unsigned char *a_string_Ptr
+ * 					: Flash address of string to display on the screen
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displayStringOnNewScreenFlash(const uint8 *a_string_Ptr){
+	LCD_clearScreen();						/* Clear LCD Screen */
+	LCD_displayStringFlash(a_string_Ptr);	/* Display string from flash */
+}
+
 /*******************************************************************************
  * [Function Name]	: LCD_integerToString
  * [Description]	: Display integers on LCD
@@ -259,3 +484,354 @@ void LCD_integerToString(sint32 a_data){
 	itoa(a_data,buff,10); 			/* integer to ASCII to convert a_data to ASCII with base 10 */
 	LCD_displayString(buff);		/* Call LCD_displayString to start displaying integer */
 }
+
+/*******************************************************************************
+ * [Function Name]	: LCD_layoutString
+ * [Description]	: Write a string into shadow in a single pass, wrapping words that
+ * 					  do not fit on cursor row to next row
+ *
+ * 					  Characters are written as they are read, when a word runs past
+ * 					  end of row its part already written is moved to next row. A
+ * 					  word longer than a row is broken where row ends. Text past last
+ * 					  row is dropped. tools/gen_layout.py mirrors this to precompute
+ * 					  breaks of fixed messages, keep both in step.
+ * [Args]
+ * 		[IN] const unsigned char *a_string_Ptr
+ * 					: String to write
+ * 		[IN] bool a_flash
+ * 					: TRUE if string is in program memory, FALSE if in SRAM
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void LCD_layoutString(const uint8 *a_string_Ptr, bool a_flash){
+	uint8 wordCol = g_cursorCol;							/* Column where current word started on cursor row */
+	uint8 character;										/* Character being written */
+	while ((character = LCD_READ_CHARACTER(a_string_Ptr++, a_flash)) != '\0'){	/* Pass by string once until null character */
+		if (' ' == character){								/* Spaces end words */
+			if (g_cursorCol >= NUMBER_OF_LCD_COLS)			/* Space past end of row is where row breaks */
+				LCD_newLine();
+			else
+				LCD_putCharacter(' ');
+			wordCol = g_cursorCol;							/* Next word starts after space */
+			continue;
+		}
+		if (g_cursorCol >= NUMBER_OF_LCD_COLS){				/* Word does not fit on row */
+			LCD_wrapWord(wordCol);
+			wordCol = 0;									/* Word now starts a row */
+		}
+		LCD_putCharacter(character);
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_wrapWord
+ * [Description]	: Move part of a word written from a column to end of row to start
+ * 					  of next row, a word starting the row is broken instead
+ * [Args]
+ * 		[IN] unsigned char a_wordCol
+ * 					: Column where word started on cursor row
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void LCD_wrapWord(uint8 a_wordCol){
+	uint8 row = g_cursorRow;								/* Row word is on */
+	if (row + 1 >= NUMBER_OF_LCD_ROWS)						/* No row left, rest of text is dropped */
+		return;
+	LCD_newLine();
+	if (a_wordCol == 0)										/* Word fills whole row, break it */
+		return;
+	for (uint8 col = a_wordCol; col < NUMBER_OF_LCD_COLS; col++){
+		LCD_putCharacter(g_frame[row][col]);				/* Continue word on next row */
+		if (g_frame[row][col] != ' '){						/* Blank its old place */
+			g_frame[row][col] = ' ';
+			g_dirty = TRUE;
+		}
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_newLine
+ * [Description]	: Move cursor to start of next row, past end of row if on last row
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void LCD_newLine(void){
+	if (g_cursorRow + 1 < NUMBER_OF_LCD_ROWS)
+		LCD_goToRowColumn(g_cursorRow + 1, 0);				/* Continue on next row */
+	else
+		g_cursorCol = NUMBER_OF_LCD_COLS;					/* Drop rest of text */
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_kick
+ * [Description]	: Schedule service right away if it is not running
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void LCD_kick(void){
+	uint8 sreg = SREG;							/* Save interrupt state */
+	cli();										/* Service can not go idle between check and schedule */
+	if (!g_running){
+		g_running = TRUE;
+		TIMER1_schedule(&g_serviceDeadline, TIMER1_MIN_DELAY);
+	}
+	SREG = sreg;								/* Restore interrupt state */
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_service
+ * [Description]	: Service deadline callback, does one LCD operation and
+ * 					  reschedules itself after its execution time while there is work
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void LCD_service(void){
+	uint32 delay;								/* Ticks until LCD accepts next operation */
+	PROFILER_MEASURE(PROFILER_SITE_LCD, delay = LCD_serviceOperation());
+	if (delay == 0){							/* Nothing left, stay quiet until kicked */
+		g_running = FALSE;
+		return;
+	}
+	TIMER1_schedule(&g_serviceDeadline, delay);
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_serviceOperation
+ * [Description]	: Send next queued command, or next changed cell once queue is empty
+ * [Args]			: N/A
+ * [Returns]		: Ticks before next operation, 0 if there is nothing to do
+ *******************************************************************************/
+static uint32 LCD_serviceOperation(void){
+#if LCD_BUSY_FLAG
+	if (LCD_isBusy() && ++g_busyPolls < LCD_BUSY_MAX_POLLS)	/* Still executing, give up on a missing LCD */
+		return LCD_SERVICE_PERIOD;
+	g_busyPolls = 0;
+#endif
+
+	uint8 tail = g_commandTail;					/* Only service moves tail */
+	if (tail != g_commandHead){					/* Commands go first, they may set-up LCD */
+		uint8 command = g_commands[tail];
+		g_commandTail = (tail + 1) & (LCD_QUEUE_SIZE - 1);	/* Free its slot */
+		LCD_write(command, LOW);
+		g_address = LCD_NO_ADDRESS;				/* Command may have moved address counter */
+		if (command <= LCD_COMMAND_RETURN_HOME_MAX)	/* Clear display and return home are slow */
+			return LCD_CLEAR_TIME;
+		return LCD_SERVICE_PERIOD;
+	}
+
+	if (LCD_serviceGlyphs())					/* Glyphs go before cells showing them */
+		return LCD_SERVICE_PERIOD;
+	if (g_marquee != LCD_MARQUEE_OFF)			/* Marquee owns display, shadow waits until it stops */
+		return LCD_serviceMarquee() ? LCD_SERVICE_PERIOD : 0;
+	if (LCD_serviceFrame())						/* Shadow cell or its address written */
+		return LCD_SERVICE_PERIOD;
+	return 0;
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_serviceGlyphs
+ * [Description]	: Upload pending glyphs to CGRAM, one row per call after setting
+ * 					  CGRAM address of slot
+ * [Args]			: N/A
+ * [Returns]		: TRUE if a write was done, FALSE if no glyph is pending
+ *******************************************************************************/
+static bool LCD_serviceGlyphs(void){
+	if (g_glyphUpload == LCD_GLYPH_SLOTS){			/* No upload in progress */
+		if (g_glyphPending == 0)
+			return FALSE;
+		uint8 slot = 0;
+		while (!BIT_IS_SET(g_glyphPending, slot))	/* Lowest pending slot */
+			slot++;
+		CLEAR_BIT(g_glyphPending, slot);			/* Reloading slot from now on starts a new upload */
+		g_glyphUpload = slot;
+		g_glyphRow = 0;
+		LCD_write(LCD_COMMAND_SET_CGRAM_ADDRESS | (slot << 3), LOW);
+		g_address = LCD_NO_ADDRESS;					/* Address counter now points into CGRAM */
+		return TRUE;
+	}
+	LCD_write(pgm_read_byte(g_glyphs[g_glyphUpload] + g_glyphRow), HIGH);	/* Write glyph row */
+	if (++g_glyphRow == LCD_GLYPH_ROWS)				/* Glyph complete */
+		g_glyphUpload = LCD_GLYPH_SLOTS;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_serviceMarquee
+ * [Description]	: Load marquee text into whole DDRAM line one character per call,
+ * 					  then send requested scroll steps
+ * [Args]			: N/A
+ * [Returns]		: TRUE if a write was done, FALSE if waiting for next step
+ *******************************************************************************/
+static bool LCD_serviceMarquee(void){
+	if (g_marquee == LCD_MARQUEE_RUNNING){			/* Text loaded, only scroll */
+		if (g_marqueeShifts == 0)
+			return FALSE;
+		g_marqueeShifts--;
+		LCD_write(LCD_COMMAND_SHIFT_DISPLAY_LEFT, LOW);	/* One command moves whole line */
+		return TRUE;
+	}
+
+	uint8 address = LCD_ROW_ADDRESS(g_marqueeRow) + g_marqueeCol;	/* DDRAM address of next character */
+	if (address != g_address){						/* Set address once, or again after a glyph upload */
+		LCD_write(LCD_COMMAND_SET_CURSOR_POSITION | address, LOW);
+		g_address = address;
+		return TRUE;
+	}
+	uint8 data = ' ';								/* Pad line after text */
+	if (!g_marqueeEnded && (data = g_marqueeSource->next(g_marqueeSource)) == '\0'){
+		g_marqueeEnded = TRUE;
+		data = ' ';
+	}
+	LCD_write(data, HIGH);
+	if (g_marqueeCol < NUMBER_OF_LCD_COLS)			/* Visible part of line overwrites shadowed cells */
+		g_panel[g_marqueeRow][g_marqueeCol] = data;
+	g_address++;									/* LCD address counter auto increments */
+	if (++g_marqueeCol == LCD_DDRAM_COLS){			/* Whole line loaded */
+		g_marquee = LCD_MARQUEE_RUNNING;
+		g_marqueeShifts = 0;
+		TIMER1_schedule(&g_marqueeDeadline, LCD_MARQUEE_PERIOD);	/* Start scrolling */
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_shiftMarquee
+ * [Description]	: Marquee deadline callback, requests one scroll step
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void LCD_shiftMarquee(void){
+	if (g_marqueeShifts < LCD_DDRAM_COLS)			/* Steps missed while LCD was busy are kept */
+		g_marqueeShifts++;
+	LCD_kick();
+}
+
+/*******************************************************************************
+ * [Function Name]	: LCD_serviceFrame
+ * [Description]	: Compare shadow with LCD from last checked cell and do one write
+ * 					  towards the first difference, a set position is only needed
+ * 					  where changed cells are not consecutive
+ * [Args]			: N/A
+ * [Returns]		: TRUE if a write was done, FALSE if LCD shows the shadow
+ *******************************************************************************/
+static bool LCD_serviceFrame(void){
+	while (1){
+		if (g_scan == LCD_CELLS){					/* End of pass */
+			if (!g_dirty)							/* Nothing changed since pass started */
+				return FALSE;
+			g_dirty = FALSE;						/* Changes from now on are caught by a new pass */
+			g_scan = 0;
+		}
+		uint8 row = g_scan / NUMBER_OF_LCD_COLS;
+		uint8 col = g_scan % NUMBER_OF_LCD_COLS;
+		uint8 data = g_frame[row][col];				/* Cell application wants */
+		if (data == g_panel[row][col]){				/* Cell already shown */
+			g_scan++;
+			continue;
+		}
+		uint8 address = LCD_ROW_ADDRESS(row) + col;	/* DDRAM address of cell */
+		if (address != g_address){					/* Reposition only when not next to last write */
+			LCD_write(LCD_COMMAND_SET_CURSOR_POSITION | address, LOW);
+			g_address = address;					/* Same cell gets written next time */
+			return TRUE;
+		}
+		LCD_write(data, HIGH);						/* Write changed cell */
+		g_panel[row][col] = data;
+		g_address = address + 1;					/* LCD address counter auto increments */
+		g_scan++;
+		return TRUE;
+	}
+}
+
+#if LCD_BUSY_FLAG
+/*******************************************************************************
+ * [Function Name]	: LCD_isBusy
+ * [Description]	: Read busy flag once
+ * [Args]			: N/A
+ * [Returns]		: TRUE if LCD is still executing last instruction
+ *******************************************************************************/
+static bool LCD_isBusy(void){
+	bool busy;								/* Busy flag read */
+
+#if DATA_BITS_MODE == 8
+	LCD_DATA_PORT_DIR = 0x00;				/* Release data pins for LCD to drive */
+	LCD_DATA_PORT = 0x00;					/* No pull-ups on data pins */
+#elif defined(UPPER_PORT_PINS)
+	LCD_DATA_PORT_DIR &= 0x0F;				/* Release data pins 4-7 for LCD to drive */
+	LCD_DATA_PORT &= 0x0F;					/* No pull-ups on data pins */
+#else
+	LCD_DATA_PORT_DIR &= 0xF0;				/* Release data pins 0-3 for LCD to drive */
+	LCD_DATA_PORT &= 0xF0;					/* No pull-ups on data pins */
+#endif
+	CLEAR_BIT(LCD_CTRL_PORT, RS);			/* Select instruction register */
+	SET_BIT(LCD_CTRL_PORT, RW);				/* Select Read mode */
+
+	SET_BIT(LCD_CTRL_PORT, E);				/* Enable LCD */
+	_delay_us(1);							/* 360ns data delay time (tDDR) */
+	busy = BIT_IS_SET(LCD_DATA_PORT_IN, LCD_BUSY_BIT) ? TRUE : FALSE;	/* Read busy flag (DB7) */
+	CLEAR_BIT(LCD_CTRL_PORT, E);			/* Disable LCD */
+#if DATA_BITS_MODE == 4
+	_delay_us(1);							/* 1us enable cycle time (tcycE) */
+	SET_BIT(LCD_CTRL_PORT, E);				/* Clock out lower nibble of status, not used */
+	_delay_us(1);
+	CLEAR_BIT(LCD_CTRL_PORT, E);
+#endif
+
+	CLEAR_BIT(LCD_CTRL_PORT, RW);			/* Back to Write mode */
+#if DATA_BITS_MODE == 8
+	LCD_DATA_PORT_DIR = 0xFF;				/* Drive data pins again */
+#elif defined(UPPER_PORT_PINS)
+	LCD_DATA_PORT_DIR |= 0xF0;				/* Drive data pins 4-7 again */
+#else
+	LCD_DATA_PORT_DIR |= 0x0F;				/* Drive data pins 0-3 again */
+#endif
+	return busy;
+}
+#endif
+
+/*******************************************************************************
+ * [Function Name]	: LCD_write
+ * [Description]	: Strobe a byte into LCD with microsecond timing, LCD must not be busy
+ * [Args]
+ * 		[IN] unsigned char a_data
+ * 					: Byte to write
+ * 		[IN] unsigned char a_rs
+ * 					: LOW for command register, HIGH for data register
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void LCD_write(uint8 a_data, uint8 a_rs){
+	if (a_rs)
+		SET_BIT(LCD_CTRL_PORT, RS); 		/* Select data register */
+	else
+		CLEAR_BIT(LCD_CTRL_PORT, RS); 		/* Select command register */
+	CLEAR_BIT(LCD_CTRL_PORT, RW);			/* Select Write mode */
+
+#if DATA_BITS_MODE == 8
+	LCD_DATA_PORT = a_data;					/* Put byte on data port */
+	SET_BIT(LCD_CTRL_PORT, E);				/* Enable LCD */
+	_delay_us(1);							/* 230ns enable pulse width (PWEH) */
+	CLEAR_BIT(LCD_CTRL_PORT, E);			/* Latch byte on falling edge */
+#else
+	/* Send the 4 MSBs first */
+#ifdef UPPER_PORT_PINS
+	LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | (a_data & 0xF0);
+#else
+	LCD_DATA_PORT = (LCD_DATA_PORT & 0xF0) | ((a_data & 0xF0) >> 4);
+#endif
+	SET_BIT(LCD_CTRL_PORT, E);				/* Enable LCD */
+	_delay_us(1);							/* 230ns enable pulse width (PWEH) */
+	CLEAR_BIT(LCD_CTRL_PORT, E);			/* Latch nibble on falling edge */
+	_delay_us(1);							/* 1us enable cycle time (tcycE) */
+
+	/* Send the 4 LSBs last */
+#ifdef UPPER_PORT_PINS
+	LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | ((a_data & 0x0F) << 4);
+#else
+	LCD_DATA_PORT = (LCD_DATA_PORT & 0xF0) | (a_data & 0x0F);
+#endif
+	SET_BIT(LCD_CTRL_PORT, E);				/* Enable LCD */
+	_delay_us(1);							/* 230ns enable pulse width (PWEH) */
+	CLEAR_BIT(LCD_CTRL_PORT, E);			/* Latch nibble on falling edge */
+#endif
+}
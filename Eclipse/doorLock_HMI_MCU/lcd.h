@@ -22,6 +22,7 @@
 #include "std_types.h"
 #include "common_macros.h"
 #include "micro_config.h"
+#include "timers.h"
 
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
@@ -29,10 +30,32 @@
 /* LCD Data bits mode configuration */
 #define DATA_BITS_MODE 8								/* Work with LCD in 8 bits mode */
 
+/* LCD timing mode, busy flag check needs RW wired, 0 paces by execution times only */
+#ifndef LCD_BUSY_FLAG
+#define LCD_BUSY_FLAG 1
+#endif
+#define LCD_POWER_UP_DELAY		40						/* Time in ms before LCD accepts commands after power up	*/
+#define LCD_BUSY_MAX_POLLS		50						/* Busy reads before giving up on a missing LCD (~3ms)	*/
+
+/* Background output, one LCD operation per timer 1 deadline */
+#define LCD_QUEUE_SIZE			8						/* Commands buffered, power of 2				*/
+#define LCD_SERVICE_PERIOD		TIMER1_US_TO_TICKS(64)	/* Longer than 43us write execution time		*/
+#define LCD_CLEAR_TIME			TIMER1_MS_TO_TICKS(2)	/* Clear display and return home take 1.52ms	*/
+
 /* LCD screen size configuration */
 #define NUMBER_OF_LCD_ROWS 2							/* Configure number of rows in LCD 		*/
 #define NUMBER_OF_LCD_COLS 16							/* Configure number of columns in LCD	*/
 
+#define LCD_NO_BREAK		0xFF						/* Row break offset marking no more rows used	*/
+
+/* Marquee, scrolls one row by shifting display */
+#define LCD_DDRAM_COLS		40							/* DDRAM columns of a line in 2 line mode	*/
+#define LCD_MARQUEE_PERIOD	TIMER1_MS_TO_TICKS(300)		/* Time between scroll steps				*/
+
+/* Custom glyphs, character codes 0 to 7 show CGRAM slots */
+#define LCD_GLYPH_SLOTS		8							/* 5x8 glyphs CGRAM holds	*/
+#define LCD_GLYPH_ROWS		8							/* Rows of a 5x8 glyph		*/
+
 /* LCD HW Pins */
 #define RS PD2											/* Register select pin 				*/
 #define RW PD3											/* Read/Write pin					*/
@@ -41,6 +64,7 @@
 #define LCD_CTRL_PORT_DIR 	DDRD						/* PORTD direction configuration	*/
 #define LCD_DATA_PORT 		PORTC						/* PORTC output pins configuration 	*/
 #define LCD_DATA_PORT_DIR 	DDRC						/* PORTC direction configuration	*/
+#define LCD_DATA_PORT_IN 	PINC						/* PORTC input pins configuration	*/
 
 /* LCD Commands */
 #define LCD_COMMAND_EIGHT_BIT_TWO_LINE_LCD		0x38	/* 8 Bit data with 2 lines display 		*/
@@ -54,7 +78,39 @@
 #define LCD_COMMAND_MOVE_CURSOR_LEFT_ONCE		0x10	/* Move cursor left once 				*/
 #define LCD_COMMAND_MOVE_CURSOR_RIGHT_ONCE		0x14	/* Move cursor right once 				*/
 #define LCD_COMMAND_CLEAR_DISPLAY				0x01	/* Clear display						*/
+#define LCD_COMMAND_RETURN_HOME					0x02	/* Undo display shift and home address	*/
+#define LCD_COMMAND_RETURN_HOME_MAX				0x03	/* Last command code of slow clear/home group	*/
 #define LCD_COMMAND_SET_CURSOR_POSITION			0X80	/* Set Cursor position					*/
+#define LCD_COMMAND_SET_CGRAM_ADDRESS			0x40	/* Set CGRAM address, slot times 8		*/
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: LCD_MarqueeState
+ * [Description]	: Enum for marquee states
+ *******************************************************************************/
+typedef enum
+{
+	LCD_MARQUEE_OFF,			/* Display shows shadow 					*/
+	LCD_MARQUEE_LOADING,		/* Text being written into DDRAM line 		*/
+	LCD_MARQUEE_RUNNING			/* Display shifted one step every period	*/
+}LCD_MarqueeState;
+
+/*******************************************************************************
+ *						Structures & Unions	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Structure Name]	: LCD_SourceType
+ * [Description]	: Struct for text decoded while it is written to LCD, placed first
+ * 					  in the state of the decoder so LCD reads through it
+ *******************************************************************************/
+typedef struct LCD_Source
+{
+	uint8 (*next)(struct LCD_Source *a_source_Ptr);	/* Returns next character, '\0' after last one */
+}LCD_SourceType;
 
 /*******************************************************************************
  *                      Function Declarations                                  *
@@ -62,7 +118,8 @@
 
 /*******************************************************************************
  * [Function Name]	: LCD_init
- * [Description]	: Initialize LCD
+ * [Description]	: Initialize LCD, set-up commands are sent in background once LCD
+ * 					  powered up, timer 1 must be initialized first
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
@@ -70,7 +127,8 @@ void LCD_init(void);
 
 /*******************************************************************************
  * [Function Name]	: LCD_sendCommand
- * [Description]	: Send command to LCD
+ * [Description]	: Queue a command to LCD, bypassing the screen shadow, waits only
+ * 					  if queue is full
  * [Args]
  * 		[IN] unsigned char a_command
  * 					: Command to send to LCD
@@ -90,6 +148,79 @@ void LCD_sendCommand(uint8 a_command);
  *******************************************************************************/
 void LCD_displayCharacter(uint8 a_data);
 
+/*******************************************************************************
+ * [Function Name]	: LCD_putCharacter
+ * [Description]	: Write a character into the shadow at cursor and advance cursor,
+ * 					  characters past end of row are not visible and are dropped
+ * [Args]
+ * 		[IN] unsigned char a_data
+ * 					: Character to write
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_putCharacter(uint8 a_data);
+
+/*******************************************************************************
+ * [Function Name]	: LCD_loadGlyph
+ * [Description]	: Make a custom glyph resident in CGRAM, uploading it in background
+ * 					  only if it is not resident already. When all slots are used the
+ * 					  glyph loaded longest ago is replaced, cells showing it change too
+ * [Args]
+ * 		[IN] const unsigned char *a_glyph_Ptr
+ * 					: Flash address of LCD_GLYPH_ROWS rows, 5 low bits per row
+ *
+ * [Returns]		: Character code showing glyph
+ *******************************************************************************/
+uint8 LCD_loadGlyph(const uint8 *a_glyph_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: LCD_startMarquee
+ * [Description]	: Scroll decoded text on cursor row. Text is loaded once into the
+ * 					  whole DDRAM line, then every step is a single display shift
+ * 					  command. HD44780 shifts all rows together and shadow is not
+ * 					  sent while marquee runs
+ * [Args]
+ * 		[IN] LCD_SourceType * a_source_Ptr
+ * 					: Text source, read in background so it must outlive marquee,
+ * 					  up to LCD_DDRAM_COLS characters
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_startMarquee(LCD_SourceType *a_source_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: LCD_stopMarquee
+ * [Description]	: Stop scrolling and return display to shadow, nothing happens if
+ * 					  no marquee runs
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_stopMarquee(void);
+
+/*******************************************************************************
+ * [Function Name]	: LCD_eraseCharacter
+ * [Description]	: Move cursor back one cell and blank it
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_eraseCharacter(void);
+
+/*******************************************************************************
+ * [Function Name]	: LCD_flush
+ * [Description]	: Start sending cells changed in the shadow to LCD in background
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_flush(void);
+
+/*******************************************************************************
+ * [Function Name]	: LCD_isIdle
+ * [Description]	: Check if LCD shows the shadow and all queued commands were sent
+ * [Args]			: N/A
+ * [Returns]		: TRUE if nothing is left to send
+ *******************************************************************************/
+bool LCD_isIdle(void);
+
 /*******************************************************************************
  * [Function Name]	: LCD_displayString
  * [Description]	: Display a string on the screen
@@ -101,6 +232,32 @@ void LCD_displayCharacter(uint8 a_data);
  *******************************************************************************/
 void LCD_displayString(const uint8 *a_string_Ptr);
 
+/*******************************************************************************
+ * [Function Name]	: LCD_displayStringFlash
+ * [Description]	: Display a string stored in program memory on the screen
+ * [Args]
+ * 		[IN] const unsigned char *a_string_Ptr
+ * 					: Flash address of string to display on the screen
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displayStringFlash(const uint8 *a_string_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: LCD_displaySourceLayout
+ * [Description]	: Display decoded text using precomputed row breaks, characters are
+ * 					  written as they are decoded and no wrapping work is done
+ * [Args]
+ * 		[IN] LCD_SourceType * a_source_Ptr
+ * 					: Text source
+ * 		[IN] const unsigned char *a_breaks_Ptr
+ * 					: Flash address of NUMBER_OF_LCD_ROWS-1 character offsets where
+ * 					  each next row starts, LCD_NO_BREAK when text ends before
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displaySourceLayout(LCD_SourceType *a_source_Ptr, const uint8 *a_breaks_Ptr);
+
 /*******************************************************************************
  * [Function Name]	: LCD_goToRowColumn
  * [Description]	: Go to location provided
@@ -129,9 +286,25 @@ void LCD_goToRowColumn(uint8 a_row, uint8 a_col);
  *******************************************************************************/
 void LCD_displayStringRowColumn(uint8 a_row, uint8 a_col, const uint8 *a_string_Ptr);
 
+/*******************************************************************************
+ * [Function Name]	: LCD_displayStringRowColumnFlash
+ * [Description]	: Display String stored in program memory at provided location
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put cursor on on LCD
+ * 		[IN] unsigned char a_col
+ * 					: Column to put cursor on on LCD
+ * 		[IN] const unsigned char *a_string_Ptr
+ * 					: Flash address of string to display on the screen
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displayStringRowColumnFlash(uint8 a_row, uint8 a_col, const uint8 *a_string_Ptr);
+
 /*******************************************************************************
  * [Function Name]	: LCD_clearScreen
- * [Description]	: Clear screen
+ * [Description]	: Clear screen shadow and home cursor, LCD is updated on next flush
+ * 					  so text drawn right after does not flicker
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
@@ -148,6 +321,17 @@ void LCD_clearScreen(void);
  *******************************************************************************/
 void LCD_displayStringOnNewScreen(const uint8 *a_string_Ptr);
 
+/*******************************************************************************
+ * [Function Name]	: LCD_displayStringOnNewScreenFlash
+ * [Description]	: Display a string stored in program memory after clearing screen
+ * [Args]
+ * 		[IN] const unsigned char *a_string_Ptr
+ * 					: Flash address of string to display on the screen
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void LCD_displayStringOnNewScreenFlash(const uint8 *a_string_Ptr);
+
 /*******************************************************************************
  * [Function Name]	: LCD_integerToString
  * [Description]	: Display integers on LCD
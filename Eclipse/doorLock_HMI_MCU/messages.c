@@ -0,0 +1,176 @@
+/******************************************************************************
+ *
+ * 		Module: Messages
+ *
+ *	 File Name: messages.c
+ *
+ * Description: Source file for flash resident LCD message catalogue, packed
+ * 				with a dictionary made at build time
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "messages.h"
+#include "messages_layout.h"
+#include "messages_packed.h"
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Row breaks are generated for one screen size, regenerate messages_layout.h after changing it */
+STATIC_ASSERT(MESSAGES_LAYOUT_COLS == NUMBER_OF_LCD_COLS && MESSAGES_LAYOUT_ROWS == NUMBER_OF_LCD_ROWS,
+			  messages_layout_generated_for_other_screen);
+
+/* Packed text is generated from messages.def, regenerate messages_packed.h after changing it */
+STATIC_ASSERT(MESSAGES_PACKED_COUNT == MESSAGES_COUNT, messages_packed_out_of_date);
+
+/* Token codes must fit in a byte */
+STATIC_ASSERT(MESSAGES_TOKEN_BASE + MESSAGES_TOKENS <= 0x100, messages_too_many_tokens);
+
+/* Marquee messages are marked with one bit each */
+STATIC_ASSERT(MESSAGES_COUNT <= 32, messages_marquee_mask_too_small);
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+/* Characters of dictionary tokens, made at build time by tools/gen_dictionary.py */
+static const uint8 g_dictionary[] PROGMEM = MESSAGES_DICTIONARY;
+
+/* Offset of each token in dictionary, token ends where next one starts */
+static const uint8 g_dictionaryOffsets[MESSAGES_TOKENS+1] PROGMEM = MESSAGES_DICTIONARY_OFFSETS;
+
+/* Packed message texts, kept in flash so start-up code does not copy them to SRAM */
+static const uint8 g_packed[] PROGMEM = MESSAGES_PACKED_TEXT;
+
+/* Offset of each packed message indexed by message ID */
+static const uint16 g_packedOffsets[MESSAGES_COUNT] PROGMEM = MESSAGES_PACKED_OFFSETS;
+
+/* Decoder read by LCD in background while a message scrolls */
+static MESSAGES_DecoderType g_marqueeDecoder;
+
+/* Offsets where each row after the first starts, made at build time by tools/gen_layout.py */
+static const uint8 g_layouts[MESSAGES_COUNT][NUMBER_OF_LCD_ROWS-1] PROGMEM = {
+#define MESSAGE(ID, TEXT)	MESSAGE_LAYOUT_##ID,
+#include "messages.def"
+#undef MESSAGE
+};
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+static uint8 MESSAGES_next(LCD_SourceType *a_source_Ptr);	/* Decode next character of a packed message */
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_open
+ * [Description]	: Start decoding a message, to be shown with LCD source APIs
+ * [Args]
+ * 		[OUT] MESSAGES_DecoderType * a_decoder_Ptr
+ * 					: Decoder state to set up, must live while message is read
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to decode
+ *
+ * [Returns]		: Source reading decoded message characters
+ *******************************************************************************/
+LCD_SourceType *MESSAGES_open(MESSAGES_DecoderType *a_decoder_Ptr, MESSAGE_Id a_id){
+	a_decoder_Ptr->source.next = MESSAGES_next;
+	a_decoder_Ptr->text = g_packed + pgm_read_word(&g_packedOffsets[a_id]);	/* First packed code */
+	a_decoder_Ptr->tokenLeft = 0;							/* Not inside a token */
+	return &a_decoder_Ptr->source;
+}
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_display
+ * [Description]	: Display a message at cursor using its precomputed row breaks,
+ * 					  messages too long for screen scroll on cursor row
+ * [Args]
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void MESSAGES_display(MESSAGE_Id a_id){
+	if (MESSAGES_MARQUEES & (1UL << a_id)){		/* Too long for screen, scroll it instead */
+		LCD_stopMarquee();						/* Service no longer reads decoder */
+		LCD_startMarquee(MESSAGES_open(&g_marqueeDecoder, a_id));
+	}
+	else{
+		MESSAGES_DecoderType decoder;			/* Read only while message is written to shadow */
+		LCD_displaySourceLayout(MESSAGES_open(&decoder, a_id), g_layouts[a_id]);	/* No wrapping work at run time */
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_displayRowColumn
+ * [Description]	: Display a message at provided location
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put cursor on on LCD
+ * 		[IN] unsigned char a_col
+ * 					: Column to put cursor on on LCD
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void MESSAGES_displayRowColumn(uint8 a_row, uint8 a_col, MESSAGE_Id a_id){
+	LCD_goToRowColumn(a_row, a_col);		/* Set message display start position */
+	MESSAGES_display(a_id);
+}
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_displayOnNewScreen
+ * [Description]	: Display a message after clearing screen
+ * [Args]
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void MESSAGES_displayOnNewScreen(MESSAGE_Id a_id){
+	LCD_clearScreen();						/* Clear LCD Screen */
+	MESSAGES_display(a_id);
+}
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_next
+ * [Description]	: Decode next character of a packed message, a token code starts
+ * 					  expanding its dictionary characters one per call
+ * [Args]
+ * 		[IN] LCD_SourceType * a_source_Ptr
+ * 					: Source of a message decoder
+ *
+ * [Returns]		: Next character, '\0' at end of message
+ *******************************************************************************/
+static uint8 MESSAGES_next(LCD_SourceType *a_source_Ptr){
+	MESSAGES_DecoderType *decoder = (MESSAGES_DecoderType *)a_source_Ptr;	/* Source is first member */
+	if (decoder->tokenLeft == 0){							/* Next code is read from packed text */
+		uint8 code = pgm_read_byte(decoder->text);
+		if (code < MESSAGES_TOKEN_BASE){					/* Plain character */
+			if (code != '\0')								/* Keep returning null character at end */
+				decoder->text++;
+			return code;
+		}
+		decoder->text++;
+		code -= MESSAGES_TOKEN_BASE;						/* Token number */
+		uint8 start = pgm_read_byte(&g_dictionaryOffsets[code]);
+		decoder->token = g_dictionary + start;
+		decoder->tokenLeft = pgm_read_byte(&g_dictionaryOffsets[code+1]) - start;
+	}
+	decoder->tokenLeft--;
+	return pgm_read_byte(decoder->token++);
+}
@@ -0,0 +1,123 @@
+ /******************************************************************************
+ *
+ * 		Module: Messages
+ *
+ *	 File Name: messages.h
+ *
+ * Description: Header file for flash resident LCD message catalogue, packed
+ * 				with a dictionary made at build time
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef MESSAGES_H_
+#define MESSAGES_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+#include "lcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Packed message codes below this are plain characters, codes from it are dictionary tokens */
+#define MESSAGES_TOKEN_BASE		0x80
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: MESSAGE_Id
+ * [Description]	: Enum for messages listed in messages.def
+ *******************************************************************************/
+typedef enum
+{
+#define MESSAGE(ID, TEXT)	MESSAGE_##ID,
+#include "messages.def"
+#undef MESSAGE
+	MESSAGES_COUNT					/* Number of messages in catalogue */
+}MESSAGE_Id;
+
+/*******************************************************************************
+ *						Structures & Unions	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Structure Name]	: MESSAGES_DecoderType
+ * [Description]	: Struct holding state of a packed message being decoded, all SRAM
+ * 					  a message needs while it is written to LCD
+ *******************************************************************************/
+typedef struct
+{
+	LCD_SourceType source;			/* Must stay first, LCD reads characters through it */
+	const uint8 *text;				/* Flash address of next packed code */
+	const uint8 *token;				/* Flash address of next character of token being expanded */
+	uint8 tokenLeft;				/* Characters of token not read yet */
+}MESSAGES_DecoderType;
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_open
+ * [Description]	: Start decoding a message, to be shown with LCD source APIs
+ * [Args]
+ * 		[OUT] MESSAGES_DecoderType * a_decoder_Ptr
+ * 					: Decoder state to set up, must live while message is read
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to decode
+ *
+ * [Returns]		: Source reading decoded message characters
+ *******************************************************************************/
+LCD_SourceType *MESSAGES_open(MESSAGES_DecoderType *a_decoder_Ptr, MESSAGE_Id a_id);
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_display
+ * [Description]	: Display a message at cursor using its precomputed row breaks,
+ * 					  messages too long for screen scroll on cursor row
+ * [Args]
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void MESSAGES_display(MESSAGE_Id a_id);
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_displayRowColumn
+ * [Description]	: Display a message at provided location
+ * [Args]
+ * 		[IN] unsigned char a_row
+ * 					: Row to put cursor on on LCD
+ * 		[IN] unsigned char a_col
+ * 					: Column to put cursor on on LCD
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void MESSAGES_displayRowColumn(uint8 a_row, uint8 a_col, MESSAGE_Id a_id);
+
+/*******************************************************************************
+ * [Function Name]	: MESSAGES_displayOnNewScreen
+ * [Description]	: Display a message after clearing screen
+ * [Args]
+ * 		[IN] MESSAGE_Id a_id
+ * 					: Message to display
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void MESSAGES_displayOnNewScreen(MESSAGE_Id a_id);
+
+#endif /* MESSAGES_H_ */
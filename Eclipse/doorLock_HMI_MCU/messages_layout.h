@@ -0,0 +1,36 @@
+/* Generated by tools/gen_layout.py from messages.def and lcd.h, do not edit */
+
+#ifndef MESSAGES_LAYOUT_H_
+#define MESSAGES_LAYOUT_H_
+
+#define MESSAGES_LAYOUT_COLS	16		/* Screen columns layout was made for */
+#define MESSAGES_LAYOUT_ROWS	2		/* Screen rows layout was made for */
+
+#define MESSAGE_LAYOUT_WELCOME	{16}
+#define MESSAGE_LAYOUT_SET_PASS	{14}
+#define MESSAGE_LAYOUT_CONFIRM_PASS	{15}
+#define MESSAGE_LAYOUT_PASS_SET	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_PASS_MISMATCH	{17}
+#define MESSAGE_LAYOUT_ENTER_PASS	{13}
+#define MESSAGE_LAYOUT_ENTER_OLD_PASS	{17}
+#define MESSAGE_LAYOUT_ACCESS_DENIED	{11}
+#define MESSAGE_LAYOUT_WRONG_PASS	{16}
+#define MESSAGE_LAYOUT_MENU_CHANGE	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_MENU_OPEN	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_ERROR_LOCKED	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_DOOR_OPENING	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_DOOR_OPEN	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_DOOR_CLOSING	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_PASS	{14}
+#define MESSAGE_LAYOUT_SERVICE_MENU	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_MENU_MORE	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_TIME	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_WINDOW	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_TRIM	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_PPM	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_SAVED	{LCD_NO_BREAK}
+#define MESSAGE_LAYOUT_SERVICE_REJECTED	{LCD_NO_BREAK}
+
+#define MESSAGES_MARQUEES	0x00000000UL	/* Messages too long for screen, scrolled on one row */
+
+#endif /* MESSAGES_LAYOUT_H_ */
@@ -0,0 +1,42 @@
+/* Generated by tools/gen_dictionary.py from messages.def, do not edit */
+/* 24 messages, plain 499 bytes, packed 417 bytes (text 305, dictionary 64, 13 tokens), ratio 1.20 */
+
+#ifndef MESSAGES_PACKED_H_
+#define MESSAGES_PACKED_H_
+
+#define MESSAGES_PACKED_COUNT	24		/* Messages packed */
+#define MESSAGES_TOKENS		13		/* Dictionary tokens */
+
+/* Token characters, token i spans offsets i to i+1 */
+#define MESSAGES_DICTIONARY	" passPlease  door not nterword your: inpen sTrimow"
+#define MESSAGES_DICTIONARY_OFFSETS	{0, 5, 12, 17, 22, 26, 30, 35, 37, 39, 42, 44, 48, 50}
+
+/* Packed messages, each ends with a null character */
+#define MESSAGES_PACKED_TEXT	\
+	"Welcome to\206\202 lock\212ystem" "\0"	/* WELCOME */ \
+	"\201set up\206\200\207" "\0"	/* SET_PASS */ \
+	"\201confirm\200\207" "\0"	/* CONFIRM_PASS */ \
+	"New\200\205\212et" "\0"	/* PASS_SET */ \
+	"Pass\205s do\203match" "\0"	/* PASS_MISMATCH */ \
+	"\201e\204\200\207" "\0"	/* ENTER_PASS */ \
+	"\201e\204 old\200\207" "\0"	/* ENTER_OLD_PASS */ \
+	"Access\203all\214ed n\214" "\0"	/* ACCESS_DENIED */ \
+	"wrong\200\205, \201try aga\210" "\0"	/* WRONG_PASS */ \
+	"X Change\200" "\0"	/* MENU_CHANGE */ \
+	"- O\211\202" "\0"	/* MENU_OPEN */ \
+	" SYSTEM LOCKED! " "\0"	/* ERROR_LOCKED */ \
+	"O\211\210g\202" "\0"	/* DOOR_OPENING */ \
+	"Door is o\211" "\0"	/* DOOR_OPEN */ \
+	"Clos\210g\202" "\0"	/* DOOR_CLOSING */ \
+	"E\204\212ervice\200\207" "\0"	/* SERVICE_PASS */ \
+	"1 Time 2 W\210d\214" "\0"	/* SERVICE_MENU */ \
+	"3 Clear 4 \213" "\0"	/* SERVICE_MENU_MORE */ \
+	"Day(1=Mon) HH:MM" "\0"	/* SERVICE_TIME */ \
+	"Daily from-to:" "\0"	/* SERVICE_WINDOW */ \
+	"Rate 1 Up 2 D\214n" "\0"	/* SERVICE_TRIM */ \
+	"\213 ppm 0-9999" "\0"	/* SERVICE_PPM */ \
+	"Sett\210gs\212aved" "\0"	/* SERVICE_SAVED */ \
+	"Value\203valid" "\0"	/* SERVICE_REJECTED */
+#define MESSAGES_PACKED_OFFSETS	{0, 24, 35, 46, 55, 71, 77, 87, 104, 123, 133, 139, 156, 162, 173, 181, 193, 207, 219, 236, 251, 267, 280, 293}
+
+#endif /* MESSAGES_PACKED_H_ */
@@ -40,4 +40,7 @@
 /* Check if a specific bit is cleared in any register and return true if yes */
 #define BIT_IS_CLEAR(REG,BIT) ( !(REG & (HIGH<<BIT)) )
 
+/* Break the build with a negative array size if a constant condition is false */
+#define STATIC_ASSERT(COND,MSG) typedef char static_assert_##MSG[(COND) ? 1 : -1]
+
 #endif
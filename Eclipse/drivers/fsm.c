@@ -0,0 +1,79 @@
+/******************************************************************************
+ *
+ * 		Module: State Machine
+ *
+ *	 File Name: fsm.c
+ *
+ * Description: Source file for table driven door lock state machine
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "fsm.h"
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Tables hold states in a byte */
+STATIC_ASSERT(FSM_STATES_COUNT <= 0x100, fsm_too_many_states);
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+/* Next state of every state and event, missing rows are FSM_STATE_NONE */
+static const uint8 g_transitions[FSM_STATES_COUNT][FSM_EVENTS_COUNT] PROGMEM = {
+#define TRANSITION(STATE, EVENT, NEXT)	[FSM_STATE_##STATE][FSM_EVENT_##EVENT] = FSM_STATE_##NEXT,
+#include "fsm.def"
+};
+
+/* State to resume after a watchdog reset in every state */
+static const uint8 g_resume[FSM_STATES_COUNT] PROGMEM = {
+#define STATE(NAME, RESUME)	[FSM_STATE_##NAME] = FSM_STATE_##RESUME,
+#include "fsm.def"
+};
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: FSM_next
+ * [Description]	: Look up state an event leads to in transition table
+ * [Args]
+ * 		[IN] FSM_StateType a_state
+ * 					: Current state
+ * 		[IN] FSM_EventType a_event
+ * 					: Event ending current state
+ *
+ * [Returns]		: Next state, FSM_STATE_NONE if event is ignored in state
+ *******************************************************************************/
+FSM_StateType FSM_next(FSM_StateType a_state, FSM_EventType a_event){
+	if (a_state >= FSM_STATES_COUNT || a_event >= FSM_EVENTS_COUNT)		/* Not in table */
+		return FSM_STATE_NONE;
+	return pgm_read_byte(&g_transitions[a_state][a_event]);				/* One table read per event */
+}
+
+/*******************************************************************************
+ * [Function Name]	: FSM_resume
+ * [Description]	: Get state to go on with after a watchdog reset in a state
+ * [Args]
+ * 		[IN] FSM_StateType a_state
+ * 					: State committed before reset
+ *
+ * [Returns]		: State to resume, FSM_STATE_NONE if committed state is unknown
+ *******************************************************************************/
+FSM_StateType FSM_resume(FSM_StateType a_state){
+	if (a_state >= FSM_STATES_COUNT)									/* Not a state */
+		return FSM_STATE_NONE;
+	return pgm_read_byte(&g_resume[a_state]);
+}
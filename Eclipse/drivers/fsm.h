@@ -0,0 +1,84 @@
+ /******************************************************************************
+ *
+ * 		Module: State Machine
+ *
+ *	 File Name: fsm.h
+ *
+ * Description: Header file for table driven door lock state machine
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef FSM_H_
+#define FSM_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: FSM_StateType
+ * [Description]	: Enum for states listed in fsm.def
+ *******************************************************************************/
+typedef enum
+{
+	FSM_STATE_NONE,					/* No transition, event is ignored */
+#define STATE(NAME, RESUME)	FSM_STATE_##NAME,
+#include "fsm.def"
+	FSM_STATES_COUNT				/* Number of states including none */
+}FSM_StateType;
+
+/*******************************************************************************
+ * [Enum Name]		: FSM_EventType
+ * [Description]	: Enum for events listed in fsm.def
+ *******************************************************************************/
+typedef enum
+{
+#define EVENT(NAME)	FSM_EVENT_##NAME,
+#include "fsm.def"
+	FSM_EVENTS_COUNT				/* Number of events */
+}FSM_EventType;
+
+/* Activity of a state, runs until an event ends the state, every MCU has its own */
+typedef FSM_EventType (*FSM_ActivityType)(void);
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: FSM_next
+ * [Description]	: Look up state an event leads to in transition table
+ * [Args]
+ * 		[IN] FSM_StateType a_state
+ * 					: Current state
+ * 		[IN] FSM_EventType a_event
+ * 					: Event ending current state
+ *
+ * [Returns]		: Next state, FSM_STATE_NONE if event is ignored in state
+ *******************************************************************************/
+FSM_StateType FSM_next(FSM_StateType a_state, FSM_EventType a_event);
+
+/*******************************************************************************
+ * [Function Name]	: FSM_resume
+ * [Description]	: Get state to go on with after a watchdog reset in a state
+ * [Args]
+ * 		[IN] FSM_StateType a_state
+ * 					: State committed before reset
+ *
+ * [Returns]		: State to resume, FSM_STATE_NONE if committed state is unknown
+ *******************************************************************************/
+FSM_StateType FSM_resume(FSM_StateType a_state);
+
+#endif /* FSM_H_ */
@@ -0,0 +1,218 @@
+/******************************************************************************
+ *
+ * 		Module: Profiler
+ *
+ *	 File Name: profiler.c
+ *
+ * Description: Source file for CPU utilisation and busy-wait accounting
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+#include "usart.h"
+#include <stdlib.h>
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define PROFILER_NAME_LENGTH	13		/* Longest site name including null terminator */
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+static volatile uint32 g_profilerOverflows;				/* Number of timer 2 overflows, upper bits of time stamp */
+static uint32 g_windowStart;							/* Time stamp at which current report window started */
+static uint32 g_siteTicks[PROFILER_SITES_NUMBER];		/* Ticks attributed to every site in current window */
+static uint16 g_siteHits[PROFILER_SITES_NUMBER];		/* Number of measurements of every site in current window */
+
+/* Site names as sent in report, kept in flash to not waste SRAM */
+static const char g_siteNames[PROFILER_SITES_NUMBER][PROFILER_NAME_LENGTH] PROGMEM = {
+	"USART_RX",
+	"USART_TX",
+	"KEYPAD",
+	"LCD",
+	"TWI",
+	"EEPROM_WRITE",
+	"TIMER_WAIT",
+	"BLIND_DELAY",
+	"PASSWORD",
+	"BOOT"
+};
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+static void PROFILER_sendNumber(uint32 a_number);		/* Send number as decimal text */
+static void PROFILER_sendLine(const char *a_name_Ptr, uint32 a_ticks, uint16 a_hits);	/* Send one report line */
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [ISR Name]		: TIMER2_OVF_vect
+ * [Description]	: ISR extending timer 2 counter to a 32 bits time stamp
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+ISR(TIMER2_OVF_vect){
+	g_profilerOverflows++;		/* Increment upper bits of time stamp */
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_init
+ * [Description]	: Start timer 2 as free running profiler time base
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROFILER_init(void){
+
+	/*
+	 * FOC2= 0		Force Output Compare		-> Not used in normal mode
+	 * WGM21:0= 0	Waveform Generation Mode	-> Normal counting mode
+	 * COM21:0= 0	Compare Match Output Mode	-> OC2 disconnected
+	 * CS22:0= 3	Clock Select				-> F_CPU/32, one tick every 32 CPU cycles
+	 */
+	TCCR2 = (HIGH << CS21) | (HIGH << CS20);
+
+	/* Start counting from 0 */
+	TCNT2 = 0;
+
+	/* Enable timer 2 overflow interrupt to extend time stamp */
+	SET_BIT(TIMSK, TOIE2);
+
+	/* Start first report window */
+	g_windowStart = 0;
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_now
+ * [Description]	: Get current profiler time stamp
+ * [Args]			: N/A
+ * [Returns]		: Time stamp in profiler ticks
+ *******************************************************************************/
+uint32 PROFILER_now(void){
+	uint8 sreg = SREG;						/* Save interrupt state */
+	cli();									/* Read counter and overflows as one value */
+	uint8 low = TCNT2;						/* Lower 8 bits from hardware counter */
+	uint32 high = g_profilerOverflows;		/* Upper bits from overflow counter */
+	if (BIT_IS_SET(TIFR, TOV2) && (low < 0x80))		/* If overflow happened but was not serviced yet */
+		high++;								/* Account for pending overflow */
+	SREG = sreg;							/* Restore interrupt state */
+	return (high << 8) | low;				/* Return combined time stamp */
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_record
+ * [Description]	: Attribute ticks passed since a time stamp to a site
+ * [Args]
+ * 		[IN] enum PROFILER_SiteType a_site
+ * 					: Site the elapsed time is attributed to
+ * 		[IN] unsigned long a_start
+ * 					: Time stamp taken when measurement started
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROFILER_record(PROFILER_SiteType a_site, uint32 a_start){
+	g_siteTicks[a_site] += PROFILER_now() - a_start;		/* Accumulate elapsed ticks */
+	g_siteHits[a_site]++;									/* Count measurement */
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_report
+ * [Description]	: Send per-site breakdown over USART and start a new window
+ *
+ * 					  Report is plain text, one "NAME TICKS HITS" line per site,
+ * 					  followed by TOTAL window ticks and WORK ticks (time not
+ * 					  spent in any wait site). Site names contain letters the
+ * 					  peer MCU parses as link symbols, so report is sent in a
+ * 					  USART_FRAME_START/USART_FRAME_END text frame the peer
+ * 					  skips with USART_receiveSymbol.
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROFILER_report(void){
+	uint32 ticks[PROFILER_SITES_NUMBER];		/* Snapshot of site ticks */
+	uint16 hits[PROFILER_SITES_NUMBER];			/* Snapshot of site hits */
+	uint32 now = PROFILER_now();				/* Time at which window ends */
+	uint32 total = now - g_windowStart;			/* Window length */
+	uint32 work = total;						/* Time not spent waiting */
+	char name[PROFILER_NAME_LENGTH];			/* Site name copied from flash */
+
+	for (uint8 site = 0; site < PROFILER_SITES_NUMBER; site++){		/* Snapshot and reset all sites */
+		ticks[site] = g_siteTicks[site];
+		hits[site] = g_siteHits[site];
+		g_siteTicks[site] = 0;
+		g_siteHits[site] = 0;
+		if (site < PROFILER_SITE_PASSWORD)		/* Wait sites are subtracted from work, work sections are not */
+			work -= ticks[site];
+	}
+	g_windowStart = now;						/* Start new window, report itself is accounted in it */
+
+	USART_sendByte(USART_FRAME_START);			/* Peer skips report */
+	PROFILER_sendLine("PROF", PROFILER_CYCLES_PER_TICK, PROFILER_SITES_NUMBER);		/* Header with tick size */
+	for (uint8 site = 0; site < PROFILER_SITES_NUMBER; site++){		/* Send every site */
+		strcpy_P(name, g_siteNames[site]);
+		PROFILER_sendLine(name, ticks[site], hits[site]);
+	}
+	PROFILER_sendLine("TOTAL", total, 1);
+	PROFILER_sendLine("WORK", work, 1);
+	USART_sendByte(USART_FRAME_END);			/* Peer parses link symbols again */
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_sendNumber
+ * [Description]	: Send number as decimal text over USART
+ * [Args]
+ * 		[IN] unsigned long a_number
+ * 					: Number to send
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void PROFILER_sendNumber(uint32 a_number){
+	char buff[11];							/* Enough for 4,294,967,295 and null terminator */
+	ultoa(a_number, buff, 10);				/* Convert number to decimal text */
+	for (uint8 i = 0; buff[i] != '\0'; i++)	/* Send digits without null terminator */
+		USART_sendByte(buff[i]);
+}
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_sendLine
+ * [Description]	: Send one "NAME TICKS HITS" report line over USART
+ * [Args]
+ * 		[IN] const char * a_name_Ptr
+ * 					: Line name
+ * 		[IN] unsigned long a_ticks
+ * 					: Ticks value of line
+ * 		[IN] unsigned short a_hits
+ * 					: Hits value of line
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void PROFILER_sendLine(const char *a_name_Ptr, uint32 a_ticks, uint16 a_hits){
+	while (*a_name_Ptr != '\0')				/* Send name */
+		USART_sendByte(*a_name_Ptr++);
+	USART_sendByte(' ');
+	PROFILER_sendNumber(a_ticks);			/* Send ticks */
+	USART_sendByte(' ');
+	PROFILER_sendNumber(a_hits);			/* Send hits */
+	USART_sendByte('\r');
+	USART_sendByte('\n');
+}
+
+#endif
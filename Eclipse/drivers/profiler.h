@@ -0,0 +1,149 @@
+ /******************************************************************************
+ *
+ * 		Module: Profiler
+ *
+ *	 File Name: profiler.h
+ *
+ * Description: Header file for CPU utilisation and busy-wait accounting
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Profiler compile-time switch, build with -DPROFILER_ENABLED=1 to instrument */
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+#define PROFILER_CYCLES_PER_TICK	32		/* Timer 2 runs at F_CPU/32, 1 tick = 32 CPU cycles	*/
+#define PROFILER_REQUEST			'?'		/* Byte requesting a profiler report over USART 	*/
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: PROFILER_SiteType
+ * [Description]	: Enum for named wait sites and work sections being measured
+ *******************************************************************************/
+typedef enum
+{
+	PROFILER_SITE_USART_RX,			/* Polling for RXC in USART_receiveByte			*/
+	PROFILER_SITE_USART_TX,			/* Polling for UDRE in USART_sendByte			*/
+	PROFILER_SITE_KEYPAD,			/* Scanning keypad until a key is pressed		*/
+	PROFILER_SITE_LCD,				/* Strobe delays in LCD command/data writes		*/
+	PROFILER_SITE_TWI,				/* Polling for TWINT in TWI operations			*/
+	PROFILER_SITE_EEPROM_WRITE,		/* Write cycle delay before EEPROM writes		*/
+	PROFILER_SITE_TIMER_WAIT,		/* Waiting on g_timePassed in timed states		*/
+	PROFILER_SITE_BLIND_DELAY,		/* Fixed delays holding messages or keys		*/
+	PROFILER_SITE_PASSWORD,			/* Work section: password handling				*/
+	PROFILER_SITE_BOOT,				/* Power up until ready, in first report only	*/
+	PROFILER_SITES_NUMBER			/* Number of sites, keep last					*/
+}PROFILER_SiteType;
+
+/*******************************************************************************
+ *                      Function-like Macros                                   *
+ *******************************************************************************/
+
+#if PROFILER_ENABLED
+
+/*******************************************************************************
+ * [Macro Name]		: PROFILER_MEASURE
+ * [Description]	: Runs a statement and attributes the time it took to a site
+ * [Args]
+ * 		[IN] enum SITE
+ * 					: Site the elapsed time is attributed to
+ * 		[IN] STATEMENT
+ * 					: Statement (usually a poll loop) being measured
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+#define PROFILER_MEASURE(SITE, STATEMENT) do{						\
+		uint32 l_profilerStart = PROFILER_now();					\
+		STATEMENT;													\
+		PROFILER_record((SITE), l_profilerStart);					\
+	}while(0)
+
+/*******************************************************************************
+ * [Macro Name]		: PROFILER_RECORD_SINCE_START
+ * [Description]	: Attributes time passed since profiler was initialized to a site
+ * [Args]
+ * 		[IN] enum SITE
+ * 					: Site the elapsed time is attributed to
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+#define PROFILER_RECORD_SINCE_START(SITE)	PROFILER_record((SITE), 0)
+
+#else
+
+#define PROFILER_MEASURE(SITE, STATEMENT) do{ STATEMENT; }while(0)
+#define PROFILER_RECORD_SINCE_START(SITE)
+#define PROFILER_init()
+#define PROFILER_report()
+
+#endif
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+#if PROFILER_ENABLED
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_init
+ * [Description]	: Start timer 2 as free running profiler time base
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROFILER_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_now
+ * [Description]	: Get current profiler time stamp
+ * [Args]			: N/A
+ * [Returns]		: Time stamp in profiler ticks
+ *******************************************************************************/
+uint32 PROFILER_now(void);
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_record
+ * [Description]	: Attribute ticks passed since a time stamp to a site
+ * [Args]
+ * 		[IN] enum PROFILER_SiteType a_site
+ * 					: Site the elapsed time is attributed to
+ * 		[IN] unsigned long a_start
+ * 					: Time stamp taken when measurement started
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROFILER_record(PROFILER_SiteType a_site, uint32 a_start);
+
+/*******************************************************************************
+ * [Function Name]	: PROFILER_report
+ * [Description]	: Send per-site breakdown over USART and start a new window
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void PROFILER_report(void);
+
+#endif
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,160 @@
+/******************************************************************************
+ *
+ * 		Module: Supervisor
+ *
+ *	 File Name: supervisor.c
+ *
+ * Description: Source file for watchdog supervisor and warm restart snapshot
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "supervisor.h"
+#include <util/crc16.h>
+
+/*******************************************************************************
+ *						Structures & Unions	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Structure Name]	: SUPERVISOR_SnapshotType
+ * [Description]	: Struct holding state committed by the application
+ *******************************************************************************/
+typedef struct
+{
+	uint8 magic;		/* Snapshot marker */
+	uint8 state;		/* Last committed application state */
+	uint8 data;			/* Extra data committed with state */
+	uint8 crc;			/* CRC8 of fields above */
+}SUPERVISOR_SnapshotType;
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+/* Snapshot is kept in .noinit so start-up code does not clear it on a warm reset */
+static SUPERVISOR_SnapshotType g_snapshot __attribute__((section(".noinit")));
+
+static SUPERVISOR_ResetCause g_resetCause;		/* Cause of last reset */
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+static uint8 SUPERVISOR_crc(uint8 a_magic, uint8 a_state, uint8 a_data);	/* Calculate snapshot CRC */
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: SUPERVISOR_init
+ * [Description]	: Read and clear reset cause then start the watchdog
+ * [Args]			: N/A
+ * [Returns]		: Cause of last reset
+ *******************************************************************************/
+SUPERVISOR_ResetCause SUPERVISOR_init(void){
+
+	/*
+	 * BIT7:5:	Reserved / ISC2		-> Not related to reset
+	 * JTRF:	JTAG Reset Flag		-> Set on JTAG reset
+	 * WDRF:	Watchdog Reset Flag	-> Set on watchdog reset
+	 * BORF:	Brown-out Reset Flag	-> Set on brown-out reset
+	 * EXTRF:	External Reset Flag	-> Set on reset pin reset
+	 * PORF:	Power-on Reset Flag	-> Set on power-on reset
+	 */
+	uint8 flags = MCUCSR;
+
+	/* Clear reset flags so next reset reports its own cause only */
+	MCUCSR = flags & ~((HIGH << JTRF) | (HIGH << WDRF) | (HIGH << BORF) | (HIGH << EXTRF) | (HIGH << PORF));
+
+	/* Power-on has priority as it may be reported together with other flags */
+	if (BIT_IS_SET(flags, PORF))
+		g_resetCause = SUPERVISOR_RESET_POWER_ON;
+	else if (BIT_IS_SET(flags, WDRF))
+		g_resetCause = SUPERVISOR_RESET_WATCHDOG;
+	else if (BIT_IS_SET(flags, BORF))
+		g_resetCause = SUPERVISOR_RESET_BROWN_OUT;
+	else if (BIT_IS_SET(flags, JTRF))
+		g_resetCause = SUPERVISOR_RESET_JTAG;
+	else
+		g_resetCause = SUPERVISOR_RESET_EXTERNAL;
+
+	/* Snapshot content is garbage after power loss */
+	if (SUPERVISOR_RESET_POWER_ON == g_resetCause || SUPERVISOR_RESET_BROWN_OUT == g_resetCause)
+		g_snapshot.magic = 0;
+
+	/* Start watchdog, from now on main loop has to kick it */
+	wdt_enable(SUPERVISOR_TIMEOUT);
+
+	return g_resetCause;
+}
+
+/*******************************************************************************
+ * [Function Name]	: SUPERVISOR_commit
+ * [Description]	: Save application state to survive a watchdog reset
+ * [Args]
+ * 		[IN] unsigned char a_state
+ * 					: Application state to resume
+ * 		[IN] unsigned char a_data
+ * 					: Extra application data saved with state
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void SUPERVISOR_commit(uint8 a_state, uint8 a_data){
+	g_snapshot.magic = 0;						/* Invalidate snapshot while it is being changed */
+	g_snapshot.state = a_state;					/* Save state */
+	g_snapshot.data = a_data;					/* Save data */
+	g_snapshot.crc = SUPERVISOR_crc(SUPERVISOR_SNAPSHOT_MAGIC, a_state, a_data);	/* Protect content */
+	g_snapshot.magic = SUPERVISOR_SNAPSHOT_MAGIC;	/* Validate snapshot */
+}
+
+/*******************************************************************************
+ * [Function Name]	: SUPERVISOR_restore
+ * [Description]	: Get last committed state if MCU was reset by the watchdog
+ * [Args]
+ * 		[OUT] unsigned char * a_state_Ptr
+ * 					: Variable to read committed state into
+ * 		[OUT] unsigned char * a_data_Ptr
+ * 					: Variable to read committed data into
+ *
+ * [Returns]		: TRUE if a valid snapshot was restored, FALSE on cold start
+ *******************************************************************************/
+bool SUPERVISOR_restore(uint8 *a_state_Ptr, uint8 *a_data_Ptr){
+	if (SUPERVISOR_RESET_WATCHDOG != g_resetCause)			/* Only resume after a watchdog reset */
+		return FALSE;
+	if (SUPERVISOR_SNAPSHOT_MAGIC != g_snapshot.magic)		/* No snapshot committed */
+		return FALSE;
+	if (SUPERVISOR_crc(g_snapshot.magic, g_snapshot.state, g_snapshot.data) != g_snapshot.crc)	/* Snapshot corrupted */
+		return FALSE;
+	*a_state_Ptr = g_snapshot.state;						/* Restore state */
+	*a_data_Ptr = g_snapshot.data;							/* Restore data */
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]	: SUPERVISOR_crc
+ * [Description]	: Calculate CRC8 over snapshot fields
+ * [Args]
+ * 		[IN] unsigned char a_magic
+ * 					: Snapshot marker
+ * 		[IN] unsigned char a_state
+ * 					: Committed state
+ * 		[IN] unsigned char a_data
+ * 					: Committed data
+ *
+ * [Returns]		: CRC8 of provided fields
+ *******************************************************************************/
+static uint8 SUPERVISOR_crc(uint8 a_magic, uint8 a_state, uint8 a_data){
+	uint8 crc = 0;								/* CRC initial value */
+	crc = _crc_ibutton_update(crc, a_magic);	/* Add marker */
+	crc = _crc_ibutton_update(crc, a_state);	/* Add state */
+	return _crc_ibutton_update(crc, a_data);	/* Add data */
+}
@@ -0,0 +1,108 @@
+ /******************************************************************************
+ *
+ * 		Module: Supervisor
+ *
+ *	 File Name: supervisor.h
+ *
+ * Description: Header file for watchdog supervisor and warm restart snapshot
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *******************************************************************************/
+
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "micro_config.h"
+#include <avr/wdt.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * Watchdog timeout, must be longer than any healthy stretch of code between two
+ * kicks. Longest is saving the password record (PROVISION_save), two 12 bytes
+ * slots written a byte at a time, about 24 writes of 10ms or 240ms. LCD is
+ * drawn in background.
+ */
+#define SUPERVISOR_TIMEOUT		WDTO_500MS
+
+#define SUPERVISOR_SNAPSHOT_MAGIC	0xA5	/* Marks snapshot written by this firmware */
+
+/*******************************************************************************
+ *							  ENUMS 	  	   		                           *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Enum Name]		: SUPERVISOR_ResetCause
+ * [Description]	: Enum for reset causes read from MCUCSR
+ *******************************************************************************/
+typedef enum
+{
+	SUPERVISOR_RESET_POWER_ON,		/* Power-on reset 						*/
+	SUPERVISOR_RESET_EXTERNAL,		/* Reset pin pulled low 				*/
+	SUPERVISOR_RESET_BROWN_OUT,		/* Supply voltage dropped below BOD level	*/
+	SUPERVISOR_RESET_WATCHDOG,		/* Watchdog timer expired 				*/
+	SUPERVISOR_RESET_JTAG			/* JTAG reset instruction 				*/
+}SUPERVISOR_ResetCause;
+
+/*******************************************************************************
+ *                      Function-like Macros                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Macro Name]		: SUPERVISOR_kick
+ * [Description]	: Reset the watchdog, call only from the healthy main loop
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+#define SUPERVISOR_kick() wdt_reset()
+
+/*******************************************************************************
+ *                      Function Declarations                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]	: SUPERVISOR_init
+ * [Description]	: Read and clear reset cause then start the watchdog
+ * [Args]			: N/A
+ * [Returns]		: Cause of last reset
+ *******************************************************************************/
+SUPERVISOR_ResetCause SUPERVISOR_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: SUPERVISOR_commit
+ * [Description]	: Save application state to survive a watchdog reset
+ * [Args]
+ * 		[IN] unsigned char a_state
+ * 					: Application state to resume
+ * 		[IN] unsigned char a_data
+ * 					: Extra application data saved with state
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void SUPERVISOR_commit(uint8 a_state, uint8 a_data);
+
+/*******************************************************************************
+ * [Function Name]	: SUPERVISOR_restore
+ * [Description]	: Get last committed state if MCU was reset by the watchdog
+ * [Args]
+ * 		[OUT] unsigned char * a_state_Ptr
+ * 					: Variable to read committed state into
+ * 		[OUT] unsigned char * a_data_Ptr
+ * 					: Variable to read committed data into
+ *
+ * [Returns]		: TRUE if a valid snapshot was restored, FALSE on cold start
+ *******************************************************************************/
+bool SUPERVISOR_restore(uint8 *a_state_Ptr, uint8 *a_data_Ptr);
+
+#endif /* SUPERVISOR_H_ */
@@ -0,0 +1,331 @@
+/******************************************************************************
+ *
+ * 		Module: ATMega16 Integrated Timers
+ *
+ *	 File Name: timers.c
+ *
+ * Description: Source file for integrated timer modules
+ *
+ * 		Author: Mohamed Mahfouz
+ *
+ *  Created on: Nov 24, 2020
+ *
+ *******************************************************************************/
+//TODO: COMMENTS IN THIS WHOLE THING
+/*******************************************************************************
+ *							  INCLUDES	  	   		                           *
+ *******************************************************************************/
+
+#include "timers.h"
+
+/*******************************************************************************
+ *                      Static Configuration Checks                            *
+ *******************************************************************************/
+
+/* Mode 13 is reserved and modes above 15 do not exist */
+STATIC_ASSERT((TIMER1_STATIC_WAVEFORM) <= FAST_PWM_OCR1A && (TIMER1_STATIC_WAVEFORM) != 13, timer1_invalid_waveform_mode);
+
+/* Deadlines need a free running counter, compare A follows the nearest deadline */
+STATIC_ASSERT((TIMER1_STATIC_WAVEFORM) == NORMAL_COUNTING, timer1_mode_must_be_normal);
+
+/* Timer must have an internal clock */
+STATIC_ASSERT((TIMER1_STATIC_PRESCALER) >= NO_PRESCALING && (TIMER1_STATIC_PRESCALER) <= FCPU_1024, timer1_invalid_prescaler);
+
+/* Millisecond conversions assume a whole number of ticks per millisecond */
+STATIC_ASSERT(TIMER1_TICKS_PER_SECOND % 1000UL == 0, timer1_ticks_not_whole_ms);
+
+/* Compare output modes are 2 bits wide */
+STATIC_ASSERT((TIMER1_STATIC_COMPARE_A) <= SET_OC1X && (TIMER1_STATIC_COMPARE_B) <= SET_OC1X, timer1_invalid_compare_mode);
+
+/* Counter is 16 bits wide */
+STATIC_ASSERT((TIMER1_STATIC_INITIAL_VALUE) <= 0xFFFFUL, timer1_invalid_initial_value);
+
+/*******************************************************************************
+ *                      Global Variables                              	   	   *
+ *******************************************************************************/
+
+volatile uint8 g_timePassed;				/* Variable to save time passed */
+static volatile uint16 g_timerEpoch;		/* Number of timer 1 overflows, upper bits of time stamp */
+static TIMER_DeadlineType *g_deadlines;		/* Pending deadlines sorted by expiry */
+
+/*******************************************************************************
+ *                    Private Function Prototypes                              *
+ *******************************************************************************/
+
+static void TIMER1_countSecond(void);							/* Seconds deadline callback */
+static void TIMER1_insert(TIMER_DeadlineType *a_deadline_Ptr);	/* Link deadline into pending list */
+static uint8 TIMER1_remove(TIMER_DeadlineType *a_deadline_Ptr);	/* Unlink deadline from pending list */
+static void TIMER1_program(void);								/* Program compare A to nearest deadline */
+
+/* Deadline counting seconds in g_timePassed between TIMER1_start and TIMER1_stop */
+static TIMER_DeadlineType g_secondDeadline = {0, TIMER1_TICKS_PER_SECOND, TIMER1_countSecond, NULL};
+
+/*******************************************************************************
+ *                      Function Definitions                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [ISR Name]		: TIMER1_OVF_vect
+ * [Description]	: ISR extending timer 1 counter to a 32 bits time stamp
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+ISR(TIMER1_OVF_vect){
+	g_timerEpoch++;		/* Increment upper bits of time stamp */
+}
+
+/*******************************************************************************
+ * [ISR Name]		: TIMER1_COMPA_vect
+ * [Description]	: ISR running callbacks of due deadlines and programming the next one
+ *
+ * 					  Compare A only holds lower 16 bits of the nearest expiry,
+ * 					  a deadline more than one overflow away fires an early
+ * 					  match every overflow that is just reprogrammed.
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+ISR(TIMER1_COMPA_vect){
+	TIMER_DeadlineType *deadline;			/* Deadline being served */
+	while (g_deadlines != NULL && (sint32)(g_deadlines->expiry - TIMER1_now()) <= 0){	/* While nearest deadline is due */
+		deadline = g_deadlines;				/* Take nearest deadline */
+		g_deadlines = deadline->next;		/* Unlink it */
+		deadline->next = NULL;
+		if (deadline->period != 0){			/* Re-arm periodic deadline relative to its expiry to not drift */
+			deadline->expiry += deadline->period;
+			TIMER1_insert(deadline);
+		}
+		deadline->callback();				/* Serve deadline, its own schedule or cancel replaces re-arm */
+	}
+	TIMER1_program();						/* Wait for next deadline */
+}
+
+/*******************************************************************************
+ * [Function Name]	: FOC1X
+ * [Description]	: returns value of Force Output Compare depending on mode chosen
+ * [Args]
+ * 		[IN] enum TIMER_WaveformGenerationMode mode
+ * 					: Waveform generation mode to choose FOC value
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static inline uint8 FOC1X(TIMER_WaveformGenerationMode mode){
+	/* Control FOC1X bit value according to chosen waveform generation mode */
+	switch(mode){
+	case 0:			/* NORMAL_COUNTING */
+	case 4:			/* CLEAR_TIMER_COMPARE_OCR1A */
+	case 12:		/* CLEAR_TIMER_COMPARE_ICR1 */
+		return 1;
+	default:		/* Any PWM mode */
+		return 0;
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_init
+ * [Description]	: Initialize integrated timer 1
+ * [Args]
+ * 		[IN] const TIMERS_ConfigType * a_s_configuration_Ptr
+ * 					: Pointer to structure containing timer configuration
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_init(const TIMERS_ConfigType * a_s_configuration_Ptr){
+
+	/*
+	 * COM1A1:0:	Compare Output Mode for Channel A		-> Compare output mode A control from configuration provided
+	 * COM1B1:0:	Compare Output Mode for Channel B		-> Compare output mode B control from configuration provided
+	 * FOC1A:		Force Output Compare for Channel A		-> Force output compare A calculated from configuration provided
+	 * FOC1B:		Force Output Compare for Channel B		-> Force output compare B calculated from configuration provided
+	 * WGM11:0:		Waveform Generation Mode				-> Waveform generation mode control from configuration provided
+	 */
+	TCCR1A = (a_s_configuration_Ptr->compareMatchA << COM1A0) |
+			 (a_s_configuration_Ptr->compareMatchB << COM1B0) |
+			(FOC1X(a_s_configuration_Ptr->waveForm) << FOC1A) |
+			(FOC1X(a_s_configuration_Ptr->waveForm) << FOC1B) |
+			(a_s_configuration_Ptr->waveForm & 0x03);
+
+	/*
+	 * ICNC1:	Input Capture Noise Canceler	-> Set to activate the Input Capture Noise Canceler
+	 * ICES1:	Input Capture Edge Select		-> Select edge used to trigger a capture event on ICP1 pin
+	 * BIT5:	Reserved Bit					-> (Read Only)
+	 * WGM13:2:	Waveform Generation Mode		-> Waveform generation mode control from configuration provided
+	 * CS12:0:	Clock Select					-> Prescaler control from configuration provided
+	 */
+	TCCR1B = (((a_s_configuration_Ptr->waveForm & 0x0C) >> 2) << WGM12) |
+			(a_s_configuration_Ptr->prescaler);
+
+	/* Set top value in ICR1 register, only used by modes with ICR1 as top */
+	ICR1 = a_s_configuration_Ptr->topValue;
+
+	/* Set Start value in TCNT1 register */
+	TCNT1 = a_s_configuration_Ptr->initialValue;
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_initStatic
+ * [Description]	: Initialize integrated timer 1 from compile-time configuration
+ * 					  (TIMER1_STATIC_* macros), all register values are constants
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_initStatic(void){
+	TCCR1A = TIMER1_STATIC_TCCR1A;					/* Compare output modes, FOC and WGM11:0 */
+	TCCR1B = TIMER1_STATIC_TCCR1B;					/* WGM13:2 and clock select */
+	TCNT1 = TIMER1_STATIC_INITIAL_VALUE;			/* Set timer initial value */
+	g_timerEpoch = 0;								/* Start time stamps from initial value */
+	g_deadlines = NULL;								/* No deadline pending */
+	SET_BIT(TIFR, TOV1);							/* Clear overflow flag for safety */
+	SET_BIT(TIMSK, TOIE1);							/* Enable overflow interrupt to extend time stamp */
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_now
+ * [Description]	: Get current timer 1 time stamp, counter extended by overflows
+ * [Args]			: N/A
+ * [Returns]		: Time stamp in timer 1 ticks
+ *******************************************************************************/
+uint32 TIMER1_now(void){
+	uint8 sreg = SREG;						/* Save interrupt state */
+	cli();									/* Read counter and overflows as one value */
+	uint16 low = TCNT1;						/* Lower 16 bits from hardware counter */
+	uint16 high = g_timerEpoch;				/* Upper bits from overflow counter */
+	if (BIT_IS_SET(TIFR, TOV1) && (low < 0x8000))	/* If overflow happened but was not serviced yet */
+		high++;								/* Account for pending overflow */
+	SREG = sreg;							/* Restore interrupt state */
+	return ((uint32)high << 16) | low;		/* Return combined time stamp */
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_schedule
+ * [Description]	: Schedule a deadline after a delay, rescheduling it if already pending
+ * [Args]
+ * 		[IN] TIMER_DeadlineType * a_deadline_Ptr
+ * 					: Deadline with callback and period set by caller
+ * 		[IN] unsigned long a_delay
+ * 					: Ticks from now until deadline is due
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_schedule(TIMER_DeadlineType *a_deadline_Ptr, uint32 a_delay){
+	uint8 sreg = SREG;							/* Save interrupt state */
+	cli();										/* Change list atomically */
+	TIMER1_remove(a_deadline_Ptr);				/* Drop previous expiry if pending */
+	a_deadline_Ptr->expiry = TIMER1_now() + a_delay;
+	TIMER1_insert(a_deadline_Ptr);				/* Link at its place */
+	if (g_deadlines == a_deadline_Ptr)			/* If it became the nearest deadline */
+		TIMER1_program();						/* Move compare A to it */
+	SREG = sreg;								/* Restore interrupt state */
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_cancel
+ * [Description]	: Remove a deadline from pending list, nothing happens if not pending
+ * [Args]
+ * 		[IN] TIMER_DeadlineType * a_deadline_Ptr
+ * 					: Deadline to cancel
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_cancel(TIMER_DeadlineType *a_deadline_Ptr){
+	uint8 sreg = SREG;							/* Save interrupt state */
+	cli();										/* Change list atomically */
+	if (TIMER1_remove(a_deadline_Ptr))			/* If it was the nearest deadline */
+		TIMER1_program();						/* Move compare A to next one */
+	SREG = sreg;								/* Restore interrupt state */
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_start
+ * [Description]	: Start counting seconds in g_timePassed from 0
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_start(){
+
+	/* Reset time to 0 to start a new clock */
+	g_timePassed = 0;
+
+	/* First second ends one second from now */
+	TIMER1_schedule(&g_secondDeadline, TIMER1_TICKS_PER_SECOND);
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_stop
+ * [Description]	: Stop counting seconds in g_timePassed
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_stop(){
+	/* Remove seconds deadline to stop time from incrementing */
+	TIMER1_cancel(&g_secondDeadline);
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_countSecond
+ * [Description]	: Seconds deadline callback, increments time passed
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void TIMER1_countSecond(void){
+	g_timePassed++;		/* Increment number of seconds passed */
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_insert
+ * [Description]	: Link deadline into pending list keeping it sorted by expiry
+ * [Args]
+ * 		[IN] TIMER_DeadlineType * a_deadline_Ptr
+ * 					: Deadline with expiry set, must not be pending
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void TIMER1_insert(TIMER_DeadlineType *a_deadline_Ptr){
+	TIMER_DeadlineType **link = &g_deadlines;		/* Link to rewrite to insert deadline */
+
+	/* Compare by difference so expiries keep their order when time stamp wraps */
+	while (*link != NULL && (sint32)((*link)->expiry - a_deadline_Ptr->expiry) <= 0)
+		link = &(*link)->next;
+	a_deadline_Ptr->next = *link;
+	*link = a_deadline_Ptr;
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_remove
+ * [Description]	: Unlink deadline from pending list
+ * [Args]
+ * 		[IN] TIMER_DeadlineType * a_deadline_Ptr
+ * 					: Deadline to unlink
+ *
+ * [Returns]		: TRUE if it was the nearest deadline
+ *******************************************************************************/
+static uint8 TIMER1_remove(TIMER_DeadlineType *a_deadline_Ptr){
+	TIMER_DeadlineType **link = &g_deadlines;		/* Link pointing to deadline */
+	while (*link != NULL && *link != a_deadline_Ptr)
+		link = &(*link)->next;
+	if (*link == NULL)								/* Deadline is not pending */
+		return FALSE;
+	*link = a_deadline_Ptr->next;
+	a_deadline_Ptr->next = NULL;
+	return (link == &g_deadlines);
+}
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_program
+ * [Description]	: Program compare A to nearest deadline, disable it if none pending
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+static void TIMER1_program(void){
+	uint32 target;									/* Time stamp compare A matches at */
+	if (g_deadlines == NULL){						/* Nothing pending, stay quiet until scheduled */
+		CLEAR_BIT(TIMSK, OCIE1A);
+		return;
+	}
+	do{
+		target = TIMER1_now() + TIMER1_MIN_DELAY;	/* Soonest match that can still be caught */
+		if ((sint32)(g_deadlines->expiry - target) > 0)	/* Deadline is further away */
+			target = g_deadlines->expiry;
+		OCR1A = (uint16)target;						/* Fire at lower 16 bits of target */
+	}while ((sint32)(target - TIMER1_now()) <= 0);	/* Counter passed target while writing it, match missed */
+	SET_BIT(TIMSK, OCIE1A);							/* Enable compare A interrupt */
+}
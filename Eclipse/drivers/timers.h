@@ -27,7 +27,7 @@
  *                      Global Variables                              	   	   *
  *******************************************************************************/
 
-extern uint8 g_timePassed;		/* Variable to save time passed */
+extern volatile uint8 g_timePassed;		/* Variable to save time passed */
 
 /*******************************************************************************
  *							  ENUMS 	  	   		                           *
@@ -112,6 +112,67 @@ typedef struct
 	uint8									: 6;	/* Padding */
 }TIMERS_ConfigType;
 
+/*******************************************************************************
+ * [Structure Name]	: TIMER_DeadlineType
+ * [Description]	: Struct holding a timer 1 deadline, owned by the caller and
+ * 					  linked into the pending list while scheduled
+ *******************************************************************************/
+typedef struct TIMER_Deadline
+{
+	uint32 expiry;							/* Timer 1 time stamp at which deadline is due */
+	uint32 period;							/* Ticks to re-arm after expiry, 0 for one shot */
+	void (*callback)(void);					/* Called from timer ISR when deadline is due */
+	struct TIMER_Deadline *next;			/* Next pending deadline, sorted by expiry */
+}TIMER_DeadlineType;
+
+/*******************************************************************************
+ *                  Static Configuration (TIMER1_initStatic)                   *
+ *******************************************************************************/
+
+/* Configuration folded to register constants at compile time, override with -D */
+#ifndef TIMER1_STATIC_INITIAL_VALUE
+#define TIMER1_STATIC_INITIAL_VALUE	0							/* Initial value for timer			*/
+#endif
+#ifndef TIMER1_STATIC_WAVEFORM
+#define TIMER1_STATIC_WAVEFORM		NORMAL_COUNTING				/* Waveform generation mode			*/
+#endif
+#ifndef TIMER1_STATIC_PRESCALER
+#define TIMER1_STATIC_PRESCALER		FCPU_64						/* Clock prescaler					*/
+#endif
+#ifndef TIMER1_STATIC_COMPARE_A
+#define TIMER1_STATIC_COMPARE_A		NORMAL_OPERATION			/* Action on compare match A		*/
+#endif
+#ifndef TIMER1_STATIC_COMPARE_B
+#define TIMER1_STATIC_COMPARE_B		NORMAL_OPERATION			/* Action on compare match B		*/
+#endif
+
+/* Clock divider of configured prescaler */
+#define TIMER1_STATIC_DIVIDER	((TIMER1_STATIC_PRESCALER) == NO_PRESCALING ? 1UL :		\
+								(TIMER1_STATIC_PRESCALER) == FCPU_8 ? 8UL :				\
+								(TIMER1_STATIC_PRESCALER) == FCPU_64 ? 64UL :			\
+								(TIMER1_STATIC_PRESCALER) == FCPU_256 ? 256UL : 1024UL)
+
+/* Deadline time base, 125000 ticks of 8us at 8MHz and F_CPU/64 */
+#define TIMER1_TICKS_PER_SECOND	(F_CPU / TIMER1_STATIC_DIVIDER)
+#define TIMER1_MS_TO_TICKS(MS)	((uint32)(MS) * (TIMER1_TICKS_PER_SECOND / 1000UL))
+#define TIMER1_US_TO_TICKS(US)	((uint32)(US) * (TIMER1_TICKS_PER_SECOND / 1000UL) / 1000UL)
+
+/* Closest a compare match is programmed ahead of the counter, covers the cycles
+ * from reading the counter to writing compare A. A match the counter still passes
+ * is caught by reading it again after the write. */
+#define TIMER1_MIN_DELAY		(TIMER1_US_TO_TICKS(32) ? TIMER1_US_TO_TICKS(32) : 1)
+
+/* Force output compare is only allowed in non-PWM modes */
+#define TIMER1_STATIC_FOC		(((TIMER1_STATIC_WAVEFORM) == NORMAL_COUNTING) ||								\
+								((TIMER1_STATIC_WAVEFORM) == CLEAR_TIMER_COMPARE_OCR1A) ||						\
+								((TIMER1_STATIC_WAVEFORM) == CLEAR_TIMER_COMPARE_ICR1))
+
+/* Register values, same fields as TIMER1_init computes at run time */
+#define TIMER1_STATIC_TCCR1A	(((TIMER1_STATIC_COMPARE_A) << COM1A0) | ((TIMER1_STATIC_COMPARE_B) << COM1B0) |	\
+								(TIMER1_STATIC_FOC << FOC1A) | (TIMER1_STATIC_FOC << FOC1B) |					\
+								((TIMER1_STATIC_WAVEFORM) & 0x03))
+#define TIMER1_STATIC_TCCR1B	(((((TIMER1_STATIC_WAVEFORM) & 0x0C) >> 2) << WGM12) | (TIMER1_STATIC_PRESCALER))
+
 /*******************************************************************************
  *                      Function Declarations                                  *
  *******************************************************************************/
@@ -127,9 +188,58 @@ typedef struct
  *******************************************************************************/
 void TIMER1_init(const TIMERS_ConfigType * a_s_configuration_Ptr);
 
+/*******************************************************************************
+ * [Function Name]	: TIMER1_initStatic
+ * [Description]	: Initialize integrated timer 1 from compile-time configuration
+ * 					  (TIMER1_STATIC_* macros), all register values are constants
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_initStatic(void);
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_now
+ * [Description]	: Get current timer 1 time stamp, counter extended by overflows
+ * [Args]			: N/A
+ * [Returns]		: Time stamp in timer 1 ticks
+ *******************************************************************************/
+uint32 TIMER1_now(void);
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_schedule
+ * [Description]	: Schedule a deadline after a delay, rescheduling it if already pending
+ *
+ * 					  Compare A is always programmed to the nearest pending
+ * 					  deadline, so no interrupt fires until something is due.
+ * 					  Callback runs in interrupt context and must be short, it
+ * 					  may schedule other deadlines. A periodic deadline is
+ * 					  re-armed one period after its expiry before its callback
+ * 					  runs, so a schedule or cancel of it from the callback wins
+ * 					  and a period changed there applies from the next re-arm.
+ * [Args]
+ * 		[IN] TIMER_DeadlineType * a_deadline_Ptr
+ * 					: Deadline with callback and period set by caller
+ * 		[IN] unsigned long a_delay
+ * 					: Ticks from now until deadline is due
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_schedule(TIMER_DeadlineType *a_deadline_Ptr, uint32 a_delay);
+
+/*******************************************************************************
+ * [Function Name]	: TIMER1_cancel
+ * [Description]	: Remove a deadline from pending list, nothing happens if not pending
+ * [Args]
+ * 		[IN] TIMER_DeadlineType * a_deadline_Ptr
+ * 					: Deadline to cancel
+ *
+ * [Returns]		: N/A
+ *******************************************************************************/
+void TIMER1_cancel(TIMER_DeadlineType *a_deadline_Ptr);
+
 /*******************************************************************************
  * [Function Name]	: TIMER1_start
- * [Description]	: Start timer 1 functionality
+ * [Description]	: Start counting seconds in g_timePassed from 0
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
@@ -137,7 +247,7 @@ void TIMER1_start();
 
 /*******************************************************************************
  * [Function Name]	: TIMER1_stop
- * [Description]	: Stop timer 1 functionality
+ * [Description]	: Stop counting seconds in g_timePassed
  * [Args]			: N/A
  * [Returns]		: N/A
  *******************************************************************************/
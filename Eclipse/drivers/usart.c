@@ -17,6 +17,23 @@
  *******************************************************************************/
 
 #include "usart.h"
+#include "profiler.h"
+
+/*******************************************************************************
+ *                      Static Configuration Checks                            *
+ *******************************************************************************/
+
+/* Baud rate must be reachable from F_CPU within tolerance */
+STATIC_ASSERT(USART_STATIC_BAUD_ERROR <= USART_MAX_BAUD_ERROR, usart_baud_rate_error_too_high);
+
+/* UBRR is a 12 bits register */
+STATIC_ASSERT(USART_STATIC_UBRR <= 0x0FFF, usart_baud_rate_too_low);
+
+/* Only 5 to 9 bits character sizes exist */
+STATIC_ASSERT((USART_STATIC_CHAR_SIZE) <= EIGHT_BITS || (USART_STATIC_CHAR_SIZE) == NINE_BITS, usart_invalid_character_size);
+
+/* Parity mode 1 is reserved */
+STATIC_ASSERT((USART_STATIC_PARITY) != 1 && (USART_STATIC_PARITY) <= ODD_PARITY, usart_invalid_parity);
 
 /*******************************************************************************
  *                      Global Variables                              	   	   *
@@ -24,6 +41,7 @@
 
 uint8 g_receiveStringFlag = 0;	/* Flag for receiving string using USART */
 uint8 g_recievedData;			/* Variable to receive single bytes using USART */
+static uint16 g_frameLeft;		/* Bytes left to skip in current text frame, 0 outside frames */
 
 /*******************************************************************************
  *                      Function Definitions                                   *
@@ -105,6 +123,21 @@ void USART_init(const Usart_ConfigType * a_s_configuration_Ptr){
 	UBRRL = (uint8)UBRR;
 }
 
+/*******************************************************************************
+ * [Function Name]	: USART_initStatic
+ * [Description]	: Initialize USART peripheral from compile-time configuration
+ * 					  (USART_STATIC_* macros), all register values are constants
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void USART_initStatic(void){
+	UCSRA = USART_STATIC_UCSRA;							/* Double speed mode */
+	UCSRB = USART_STATIC_UCSRB;							/* Enable RX/TX and character size bit 2 */
+	UCSRC = USART_STATIC_UCSRC;							/* Parity, stop bit and character size bits 1:0 */
+	UBRRH = (uint8)(USART_STATIC_UBRR >> 8);			/* Baud rate high byte, URSEL= 0 */
+	UBRRL = (uint8)USART_STATIC_UBRR;					/* Baud rate low byte */
+}
+
 /*******************************************************************************
  * [Function Name]	: USART_sendByte
  * [Description]	: Send byte using USART
@@ -117,7 +150,7 @@ void USART_init(const Usart_ConfigType * a_s_configuration_Ptr){
 void USART_sendByte(const uint8 a_data){
 	//TODO: Adjust for 9 bits
 	/* Wait for UDRE flag to be set before writing data for transmission */
-	while(BIT_IS_CLEAR(UCSRA, UDRE));
+	PROFILER_MEASURE(PROFILER_SITE_USART_TX, while(BIT_IS_CLEAR(UCSRA, UDRE)));
 	/* Write data to UDR to send using USART */
 	UDR = a_data;
 }
@@ -131,11 +164,50 @@ void USART_sendByte(const uint8 a_data){
 uint8 USART_receiveByte(void){
 
 	/* Wait for RXC flag to be set before reading data received */
-	while(BIT_IS_CLEAR(UCSRA, RXC));
+	PROFILER_MEASURE(PROFILER_SITE_USART_RX, while(BIT_IS_CLEAR(UCSRA, RXC)));
 	/* Read data currently in UDR */
 	return UDR;
 }
 
+/*******************************************************************************
+ * [Function Name]	: USART_isByteReceived
+ * [Description]	: Check without blocking if a byte is waiting to be read
+ * [Args]			: N/A
+ * [Returns]		: TRUE if a received byte is waiting in UDR
+ *******************************************************************************/
+bool USART_isByteReceived(void){
+	/* RXC flag is set as long as unread data is in receive buffer */
+	return BIT_IS_SET(UCSRA, RXC) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ * [Function Name]	: USART_receiveSymbol
+ * [Description]	: Take next received byte outside text frames without blocking,
+ * 					  frame bytes waiting before it are dropped. Parameters that
+ * 					  follow a symbol as binary data are read with USART_receiveByte.
+ * [Args]
+ * 		[OUT] unsigned char * a_symbol_Ptr
+ * 					: Variable to read symbol into
+ *
+ * [Returns]		: TRUE if a symbol was taken, FALSE if none is waiting
+ *******************************************************************************/
+bool USART_receiveSymbol(uint8 *a_symbol_Ptr){
+	while (BIT_IS_SET(UCSRA, RXC)){					/* Take bytes waiting until a symbol */
+		uint8 data = UDR;
+		if (USART_FRAME_START == data)				/* Text frame starts, skip it */
+			g_frameLeft = USART_FRAME_MAX_LENGTH;
+		else if (USART_FRAME_END == data)			/* Text frame ended */
+			g_frameLeft = 0;
+		else if (0 != g_frameLeft)					/* Text of frame */
+			g_frameLeft--;
+		else{										/* Link symbol */
+			*a_symbol_Ptr = data;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
 /*******************************************************************************
  * [Function Name]	: USART_sendString
  * [Description]	: Send string using USART
@@ -124,6 +124,53 @@ typedef struct
  *******************************************************************************/
 #define UBRR(F_CPU, BAUD) (((F_CPU)/((8UL)*(BAUD)))-1)
 
+/*******************************************************************************
+ *                  Static Configuration (USART_initStatic)                    *
+ *******************************************************************************/
+
+/* Configuration folded to register constants at compile time, override with -D */
+#ifndef USART_STATIC_BAUD_RATE
+#define USART_STATIC_BAUD_RATE	BAUD_RATE_9600	/* Baud rate						*/
+#endif
+#ifndef USART_STATIC_CHAR_SIZE
+#define USART_STATIC_CHAR_SIZE	EIGHT_BITS		/* Character size					*/
+#endif
+#ifndef USART_STATIC_PARITY
+#define USART_STATIC_PARITY		DISABLED		/* Parity control					*/
+#endif
+#ifndef USART_STATIC_STOP_BIT
+#define USART_STATIC_STOP_BIT	ONE_BIT			/* Stop bit control					*/
+#endif
+
+#define USART_MAX_BAUD_ERROR	20				/* Max baud rate error in per mille	*/
+
+/* UBRR rounded to nearest value for double speed mode */
+#define USART_STATIC_UBRR		(((F_CPU) + 4UL*(USART_STATIC_BAUD_RATE)) / (8UL*(USART_STATIC_BAUD_RATE)) - 1)
+
+/* Baud rate actually generated by USART_STATIC_UBRR */
+#define USART_STATIC_REAL_BAUD	((F_CPU) / (8UL*(USART_STATIC_UBRR + 1)))
+
+/* Absolute baud rate error in per mille */
+#define USART_STATIC_BAUD_ERROR	((USART_STATIC_REAL_BAUD > (USART_STATIC_BAUD_RATE)) ?									\
+		((USART_STATIC_REAL_BAUD - (USART_STATIC_BAUD_RATE)) * 1000UL / (USART_STATIC_BAUD_RATE)) :					\
+		(((USART_STATIC_BAUD_RATE) - USART_STATIC_REAL_BAUD) * 1000UL / (USART_STATIC_BAUD_RATE)))
+
+/* Register values, same fields as USART_init computes at run time */
+#define USART_STATIC_UCSRA		(HIGH << U2X)
+#define USART_STATIC_UCSRB		((HIGH << RXEN) | (HIGH << TXEN) | ((((USART_STATIC_CHAR_SIZE) & 4) >> 2) << UCSZ2))
+#define USART_STATIC_UCSRC		((HIGH << URSEL) | ((USART_STATIC_PARITY) << UPM0) |									\
+								((USART_STATIC_STOP_BIT) << USBS) | (((USART_STATIC_CHAR_SIZE) & 3) << UCSZ0))
+
+/*******************************************************************************
+ *                      Text Frames                                            *
+ *******************************************************************************/
+
+/* Text for a host listening on the line, e.g. profiler reports, is sent between
+ * these bytes and skipped by USART_receiveSymbol of the peer MCU */
+#define USART_FRAME_START		0x02			/* STX, never sent as a link symbol	*/
+#define USART_FRAME_END			0x03			/* ETX, never sent as a link symbol	*/
+#define USART_FRAME_MAX_LENGTH	1024			/* Frame is left after this many bytes if its end was lost */
+
 /*******************************************************************************
  *                      Function Declarations                                  *
  *******************************************************************************/
@@ -139,6 +186,15 @@ typedef struct
  *******************************************************************************/
 void USART_init(const Usart_ConfigType * a_s_configuration_Ptr);
 
+/*******************************************************************************
+ * [Function Name]	: USART_initStatic
+ * [Description]	: Initialize USART peripheral from compile-time configuration
+ * 					  (USART_STATIC_* macros), all register values are constants
+ * [Args]			: N/A
+ * [Returns]		: N/A
+ *******************************************************************************/
+void USART_initStatic(void);
+
 /*******************************************************************************
  * [Function Name]	: USART_sendByte
  * [Description]	: Send byte using USART
@@ -158,6 +214,27 @@ void USART_sendByte(const uint8 a_data);
  *******************************************************************************/
 uint8 USART_receiveByte(void);
 
+/*******************************************************************************
+ * [Function Name]	: USART_isByteReceived
+ * [Description]	: Check without blocking if a byte is waiting to be read
+ * [Args]			: N/A
+ * [Returns]		: TRUE if a received byte is waiting in UDR
+ *******************************************************************************/
+bool USART_isByteReceived(void);
+
+/*******************************************************************************
+ * [Function Name]	: USART_receiveSymbol
+ * [Description]	: Take next received byte outside text frames without blocking,
+ * 					  frame bytes waiting before it are dropped. Parameters that
+ * 					  follow a symbol as binary data are read with USART_receiveByte.
+ * [Args]
+ * 		[OUT] unsigned char * a_symbol_Ptr
+ * 					: Variable to read symbol into
+ *
+ * [Returns]		: TRUE if a symbol was taken, FALSE if none is waiting
+ *******************************************************************************/
+bool USART_receiveSymbol(uint8 *a_symbol_Ptr);
+
 /*******************************************************************************
  * [Function Name]	: USART_sendString
  * [Description]	: Send string using USART
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# Module: Tools
+#
+# File Name: gen_dictionary.py
+#
+# Description: Compress fixed LCD messages with a substring dictionary. Codes
+#              below 0x80 are plain ASCII, codes from 0x80 stand for a dictionary
+#              token of plain characters, decoded by MESSAGES_next in messages.c
+#
+# Author: Mohamed Mahfouz
+#
+# Created on: Oct 19, 2026
+#
+# Usage: gen_dictionary.py <messages.def> <messages_packed.h>
+
+import re
+import sys
+
+TOKEN_BASE = 0x80						# MESSAGES_TOKEN_BASE in messages.h
+MAX_TOKENS = 0x100 - TOKEN_BASE			# Codes left for tokens
+MAX_DICTIONARY = 0xFF					# Dictionary offsets are one byte
+MAX_TOKEN_LENGTH = 16					# Longest substring tried as a token
+
+MESSAGE_RE = re.compile(r'^MESSAGE\((\w+),\s*"((?:[^"\\]|\\.)*)"\)', re.M)
+
+def occurrences(symbols, candidate):
+	"""Count non overlapping occurrences of a tuple of plain characters"""
+	count, i, n = 0, 0, len(candidate)
+	while i + n <= len(symbols):
+		if tuple(symbols[i:i+n]) == candidate:
+			count += 1
+			i += n
+		else:
+			i += 1
+	return count
+
+def replace(symbols, candidate, code):
+	"""Replace non overlapping occurrences of candidate by a token code"""
+	result, i, n = [], 0, len(candidate)
+	while i < len(symbols):
+		if tuple(symbols[i:i+n]) == candidate:
+			result.append(code)
+			i += n
+		else:
+			result.append(symbols[i])
+			i += 1
+	return result
+
+def compress(texts):
+	"""Greedily pick tokens saving most bytes, return (encoded messages, tokens)"""
+	messages = [list(text) for text in texts]	# Symbols are characters or token codes
+	tokens = []
+	dictionary = 0
+	while len(tokens) < MAX_TOKENS:
+		candidates = set()
+		for symbols in messages:
+			for start in range(len(symbols)):
+				for end in range(start + 2, min(start + MAX_TOKEN_LENGTH, len(symbols)) + 1):
+					part = tuple(symbols[start:end])
+					if any(isinstance(s, int) for s in part):	# Tokens hold plain characters only
+						break
+					candidates.add(part)
+		best, gain = None, 0
+		for candidate in candidates:
+			if dictionary + len(candidate) > MAX_DICTIONARY:
+				continue
+			count = sum(occurrences(symbols, candidate) for symbols in messages)
+			# Each use saves length-1 bytes, token costs its characters and an offset byte
+			saving = count * (len(candidate) - 1) - len(candidate) - 1
+			if saving > gain or (saving == gain and best is not None and candidate < best):
+				best, gain = candidate, saving
+		if best is None:
+			break
+		code = TOKEN_BASE + len(tokens)
+		tokens.append(''.join(best))
+		dictionary += len(best)
+		messages = [replace(symbols, best, code) for symbols in messages]
+	return messages, tokens
+
+def c_string(symbols):
+	"""C string literal, token codes and quotes escaped in octal so no digit is swallowed"""
+	out = ''
+	for symbol in symbols:
+		code = symbol if isinstance(symbol, int) else ord(symbol)
+		out += '\\%03o' % code if code >= 0x7F or code < 0x20 or symbol in ('"', '\\') else symbol
+	return '"' + out + '"'
+
+def main(argv):
+	if len(argv) != 3:
+		sys.exit('usage: gen_dictionary.py <messages.def> <messages_packed.h>')
+	entries = MESSAGE_RE.findall(open(argv[1]).read())
+	texts = [bytes(text, 'ascii').decode('unicode_escape') for _, text in entries]
+	for (name, _), text in zip(entries, texts):
+		if any(ord(char) >= TOKEN_BASE or char == '\0' for char in text):
+			sys.exit('%s: message %s uses codes reserved for tokens' % (argv[1], name))
+
+	encoded, tokens = compress(texts)
+
+	# Flash taken by plain strings and their address table against packed form
+	plain = sum(len(text) + 1 for text in texts) + 2 * len(texts)
+	packed_text = sum(len(symbols) + 1 for symbols in encoded)
+	dictionary = sum(len(token) for token in tokens) + len(tokens) + 1
+	packed = packed_text + 2 * len(texts) + dictionary
+	report = ('%d messages, plain %d bytes, packed %d bytes (text %d, dictionary %d, %d tokens), ratio %.2f'
+			  % (len(texts), plain, packed, packed_text, dictionary, len(tokens), float(plain) / packed))
+	print(report)
+
+	offsets, offset = [], 0
+	for symbols in encoded:
+		offsets.append(offset)
+		offset += len(symbols) + 1
+	token_offsets, offset = [], 0
+	for token in tokens:
+		token_offsets.append(offset)
+		offset += len(token)
+	token_offsets.append(offset)
+
+	lines = ['/* Generated by tools/gen_dictionary.py from messages.def, do not edit */',
+			 '/* %s */' % report,
+			 '',
+			 '#ifndef MESSAGES_PACKED_H_',
+			 '#define MESSAGES_PACKED_H_',
+			 '',
+			 '#define MESSAGES_PACKED_COUNT	%d		/* Messages packed */' % len(texts),
+			 '#define MESSAGES_TOKENS		%d		/* Dictionary tokens */' % len(tokens),
+			 '',
+			 '/* Token characters, token i spans offsets i to i+1 */',
+			 '#define MESSAGES_DICTIONARY	%s' % c_string(''.join(tokens)),
+			 '#define MESSAGES_DICTIONARY_OFFSETS	{%s}' % ', '.join(map(str, token_offsets)),
+			 '',
+			 '/* Packed messages, each ends with a null character */',
+			 '#define MESSAGES_PACKED_TEXT	\\']
+	for (name, _), symbols in zip(entries, encoded):
+		lines.append('	%s "\\0"	/* %s */ \\' % (c_string(symbols), name))
+	lines[-1] = lines[-1][:-2]
+	lines += ['#define MESSAGES_PACKED_OFFSETS	{%s}' % ', '.join(map(str, offsets)),
+			  '',
+			  '#endif /* MESSAGES_PACKED_H_ */',
+			  '']
+
+	with open(argv[2], 'w') as output:
+		output.write('\n'.join(lines))
+
+if __name__ == '__main__':
+	main(sys.argv)
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+#
+# Module: Tools
+#
+# File Name: gen_layout.py
+#
+# Description: Generate row break offsets of fixed LCD messages for the
+#              configured screen size, mirrors LCD_layoutString in lcd.c.
+#              Messages that do not fit are marked to be shown as a marquee
+#
+# Author: Mohamed Mahfouz
+#
+# Created on: Oct 19, 2026
+#
+# Usage: gen_layout.py <messages.def> <lcd.h> <messages_layout.h>
+
+import re
+import sys
+
+NO_BREAK = 0xFF							# LCD_NO_BREAK in lcd.h
+DDRAM_COLS = 40							# LCD_DDRAM_COLS in lcd.h, longest marquee text
+
+MESSAGE_RE = re.compile(r'^MESSAGE\((\w+),\s*"((?:[^"\\]|\\.)*)"\)', re.M)
+
+def config(header, name):
+	"""Read a numeric #define from a header"""
+	match = re.search(r'^#define\s+%s\s+(\d+)' % name, open(header).read(), re.M)
+	if match is None:
+		sys.exit('%s: %s not defined' % (header, name))
+	return int(match.group(1))
+
+def layout(text, cols, rows):
+	"""Return offsets where each row after the first starts and visible characters dropped"""
+	grid = [[None] * cols for _ in range(rows)]	# Offset of character shown in each cell
+	row, col = 0, 0
+	word_col = 0						# Column where current word started on cursor row
+
+	def put(offset):
+		nonlocal col
+		if col < cols:
+			grid[row][col] = offset
+			col += 1
+
+	def new_line():
+		nonlocal row, col
+		if row + 1 < rows:
+			row, col = row + 1, 0
+		else:
+			col = cols					# Rest of text is dropped
+
+	for offset, char in enumerate(text):
+		if char == ' ':
+			if col >= cols:				# Space past end of row is where row breaks
+				new_line()
+			else:
+				put(offset)
+			word_col = col
+			continue
+		if col >= cols:					# Word does not fit on row
+			if row + 1 < rows:
+				old = row
+				new_line()
+				if word_col != 0:		# Move written part of word to next row
+					for moved in grid[old][word_col:cols]:
+						put(moved)
+					grid[old][word_col:cols] = [None] * (cols - word_col)
+			word_col = 0
+		put(offset)
+
+	shown = set(offset for cells in grid for offset in cells)
+	dropped = sum(1 for offset, char in enumerate(text) if char != ' ' and offset not in shown)
+	breaks = [cells[0] for cells in grid[1:] if cells[0] is not None]
+	return breaks + [NO_BREAK] * (rows - 1 - len(breaks)), dropped
+
+def main(argv):
+	if len(argv) != 4:
+		sys.exit('usage: gen_layout.py <messages.def> <lcd.h> <messages_layout.h>')
+	cols = config(argv[2], 'NUMBER_OF_LCD_COLS')
+	rows = config(argv[2], 'NUMBER_OF_LCD_ROWS')
+
+	lines = ['/* Generated by tools/gen_layout.py from messages.def and lcd.h, do not edit */',
+			 '',
+			 '#ifndef MESSAGES_LAYOUT_H_',
+			 '#define MESSAGES_LAYOUT_H_',
+			 '',
+			 '#define MESSAGES_LAYOUT_COLS	%d		/* Screen columns layout was made for */' % cols,
+			 '#define MESSAGES_LAYOUT_ROWS	%d		/* Screen rows layout was made for */' % rows,
+			 '']
+	marquees = 0						# Bit per message scrolled instead of wrapped
+	for index, (name, text) in enumerate(MESSAGE_RE.findall(open(argv[1]).read())):
+		text = bytes(text, 'ascii').decode('unicode_escape')
+		breaks, dropped = layout(text, cols, rows)
+		if dropped and rows <= 2 and len(text) <= DDRAM_COLS:	# Marquee needs a whole DDRAM line per row
+			marquees |= 1 << index
+		elif dropped:
+			print('%s: warning: message %s loses %d characters on a %dx%d screen'
+				  % (argv[1], name, dropped, rows, cols), file=sys.stderr)
+		lines.append('#define MESSAGE_LAYOUT_%s	{%s}' % (name, ', '.join(
+			'LCD_NO_BREAK' if b == NO_BREAK else str(b) for b in breaks)))
+	lines += ['',
+			  '#define MESSAGES_MARQUEES	0x%08XUL	/* Messages too long for screen, scrolled on one row */' % marquees,
+			  '',
+			  '#endif /* MESSAGES_LAYOUT_H_ */',
+			  '']
+
+	with open(argv[3], 'w') as output:
+		output.write('\n'.join(lines))
+
+if __name__ == '__main__':
+	main(sys.argv)
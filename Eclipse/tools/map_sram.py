@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+#
+# Module: Tools
+#
+# File Name: map_sram.py
+#
+# Description: SRAM usage report from avr-ld map files (-Wl,-Map), lists
+#              .data/.bss/.noinit bytes per object and compares two builds
+#
+# Author: Mohamed Mahfouz
+#
+# Created on: Oct 19, 2026
+#
+# Usage: map_sram.py <after.map> [<before.map>]
+
+import os
+import re
+import sys
+
+SECTIONS = ('.data', '.bss', '.noinit')	# Sections placed in SRAM
+SRAM_SIZE = 1024						# ATmega16 SRAM bytes
+
+# Input section line, name may be alone with address and size on next line
+INPUT_RE = re.compile(r'^ (\.(?:data|bss|noinit|rodata)\S*|COMMON)\s*(?:\n\s+)?(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S.*)$', re.M)
+
+def usage(path):
+	"""Return {object: {section: bytes}} from memory map part of a map file"""
+	text = open(path).read()
+	text = text[text.find('Linker script and memory map'):]	# Skip discarded sections list
+	result = {}
+	for name, address, size, obj in INPUT_RE.findall(text):
+		if not address.startswith('0x0080') or int(size, 16) == 0:	# Not in SRAM or empty
+			continue
+		if name == 'COMMON':
+			section = '.bss'								# Tentative definitions are zeroed with .bss
+		elif name.startswith('.rodata'):
+			section = '.data'								# AVR copies read only data into SRAM too
+		else:
+			section = next(s for s in SECTIONS if name.startswith(s))
+		obj = os.path.basename(obj.replace('\\', '/').split('(')[-1].rstrip(')'))
+		result.setdefault(obj, dict.fromkeys(SECTIONS, 0))[section] += int(size, 16)
+	return result
+
+def total(table):
+	return {s: sum(v[s] for v in table.values()) for s in SECTIONS}
+
+def main(argv):
+	if len(argv) not in (2, 3):
+		sys.exit('usage: map_sram.py <after.map> [<before.map>]')
+	after = usage(argv[1])
+	before = usage(argv[2]) if len(argv) == 3 else None
+
+	print('%-24s %8s %8s %8s %8s' % ('object', *SECTIONS, 'delta' if before else ''))
+	for obj in sorted(set(after) | set(before or {})):
+		row = after.get(obj, dict.fromkeys(SECTIONS, 0))
+		delta = ''
+		if before is not None:
+			old = before.get(obj, dict.fromkeys(SECTIONS, 0))
+			delta = '%+d' % (sum(row.values()) - sum(old.values()))
+		print('%-24s %8d %8d %8d %8s' % (obj, *(row[s] for s in SECTIONS), delta))
+
+	used = sum(total(after).values())
+	print('%-24s %8d %8d %8d' % ('total', *(total(after)[s] for s in SECTIONS)))
+	print('static SRAM %d of %d bytes, %d left for stack' % (used, SRAM_SIZE, SRAM_SIZE - used))
+	if before is not None:
+		old = sum(total(before).values())
+		print('before %d bytes, after %d bytes, saved %d bytes' % (old, used, old - used))
+
+if __name__ == '__main__':
+	main(sys.argv)
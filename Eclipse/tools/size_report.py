@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+#
+# Module: Tools
+#
+# File Name: size_report.py
+#
+# Description: Flash and SRAM cost per function and variable from avr-nm
+#              symbol listings of the linked firmware, compares two builds
+#
+# Author: Mohamed Mahfouz
+#
+# Created on: Oct 19, 2026
+#
+# Usage: avr-nm --print-size --size-sort firmware.elf > firmware.sym
+#        size_report.py <after.sym> [<before.sym>]
+
+import re
+import sys
+
+SRAM_START = 0x800000					# avr-ld offset of data memory addresses
+EEPROM_START = 0x810000					# avr-ld offset of EEPROM addresses
+FLASH_SIZE = 16384						# ATmega16 flash bytes
+SRAM_SIZE = 1024						# ATmega16 SRAM bytes
+INITIALIZED = 'dDrR'					# SRAM symbols with a copy of their initial value in flash
+
+# Symbol line: address, size, type and name
+SYMBOL_RE = re.compile(r'^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+(\w)\s+(\S+)$', re.M)
+
+def symbols(path):
+	"""Return {name: [flash bytes, SRAM bytes]} from an avr-nm listing"""
+	result = {}
+	for address, size, kind, name in SYMBOL_RE.findall(open(path).read()):
+		address, size = int(address, 16), int(size, 16)
+		name = re.sub(r'\.(lto_priv|constprop|isra|part)\.\d+', '', name)	# LTO clones keep their origin name
+		if address >= EEPROM_START:
+			continue
+		cost = result.setdefault(name, [0, 0])
+		if address >= SRAM_START:
+			cost[1] += size
+			if kind in INITIALIZED:
+				cost[0] += size
+		else:
+			cost[0] += size
+	return result
+
+def main(argv):
+	if len(argv) not in (2, 3):
+		sys.exit('usage: size_report.py <after.sym> [<before.sym>]')
+	after = symbols(argv[1])
+	before = symbols(argv[2]) if len(argv) == 3 else None
+
+	names = set(after) | set(before or {})
+	print('%-32s %8s %8s %8s' % ('symbol', 'flash', 'sram', 'delta' if before else ''))
+	for name in sorted(names, key=lambda n: (-sum(after.get(n, (0, 0))), n)):
+		row = after.get(name, [0, 0])
+		delta = ''
+		if before is not None:
+			old = before.get(name, [0, 0])
+			if row == old:
+				delta = ''
+			elif name not in after:
+				delta = 'removed'
+			elif name not in before:
+				delta = 'new'
+			else:
+				delta = '%+d/%+d' % (row[0] - old[0], row[1] - old[1])
+		print('%-32s %8d %8d %8s' % (name, row[0], row[1], delta))
+
+	flash = sum(v[0] for v in after.values())
+	sram = sum(v[1] for v in after.values())
+	print('%-32s %8d %8d' % ('total', flash, sram))
+	print('flash %d of %d bytes, static SRAM %d of %d bytes' % (flash, FLASH_SIZE, sram, SRAM_SIZE))
+	if before is not None:
+		old_flash = sum(v[0] for v in before.values())
+		old_sram = sum(v[1] for v in before.values())
+		print('flash %+d bytes, SRAM %+d bytes since previous build' % (flash - old_flash, sram - old_sram))
+
+if __name__ == '__main__':
+	main(sys.argv)